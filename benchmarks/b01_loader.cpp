@@ -0,0 +1,58 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+#include "ezdxf/ezdxf.hpp"
+#include "corpus.hpp"
+#include "throughput.hpp"
+#include "workloads.hpp"
+
+using ezdxf::benchmark::CorpusOptions;
+using ezdxf::benchmark::load_document;
+using ezdxf::benchmark::load_string_tags;
+using ezdxf::benchmark::load_typed_tags;
+
+static const std::string &corpus() {
+    static const auto data = ezdxf::benchmark::generate_dxf(
+            CorpusOptions{4 << 20});
+    return data;
+}
+
+TEST_CASE("Generated corpus is valid DXF.", "[corpus]") {
+    auto const &data = corpus();
+    REQUIRE(data.size() >= 4 << 20);
+    REQUIRE(data == ezdxf::benchmark::generate_dxf(CorpusOptions{4 << 20}));
+    auto basic_loader = ezdxf::tag::BasicLoader(data);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    auto doc = ezdxf::Document();
+    REQUIRE(doc.load(loader) == true);
+    REQUIRE(doc.get_errors().empty());
+}
+
+TEST_CASE("BasicLoader string tags.", "[benchmark][loader]") {
+    auto const &data = corpus();
+    auto const tags = load_string_tags(data);
+    ezdxf::benchmark::report_throughput(
+            "BasicLoader", data.size(), tags,
+            [&data]() { load_string_tags(data); });
+    BENCHMARK("BasicLoader 4 MiB") { return load_string_tags(data); };
+}
+
+TEST_CASE("AscLoader typed tags.", "[benchmark][loader]") {
+    auto const &data = corpus();
+    auto const tags = load_string_tags(data);
+    ezdxf::benchmark::report_throughput(
+            "AscLoader typed", data.size(), tags,
+            [&data]() { load_typed_tags(data); });
+    BENCHMARK("AscLoader typed 4 MiB") { return load_typed_tags(data); };
+}
+
+TEST_CASE("Document loading.", "[benchmark][loader]") {
+    auto const &data = corpus();
+    auto const tags = load_string_tags(data);
+    ezdxf::benchmark::report_throughput(
+            "Document::load", data.size(), tags,
+            [&data]() { load_document(data); });
+    BENCHMARK("Document::load 4 MiB") { return load_document(data); };
+}
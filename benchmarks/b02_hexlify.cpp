@@ -0,0 +1,42 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+#include "ezdxf/utils.hpp"
+#include "throughput.hpp"
+
+static ezdxf::Bytes make_bytes(std::size_t size) {
+    auto data = ezdxf::Bytes(size);
+    uint32_t value = 1;
+    for (auto &byte : data) {
+        value = value * 1664525u + 1013904223u;
+        byte = static_cast<unsigned char>(value >> 24);
+    }
+    return data;
+}
+
+TEST_CASE("Hexlify binary data.", "[benchmark][hexlify]") {
+    // 127 bytes is the size of binary tags written by AutoCAD:
+    auto const chunk = make_bytes(127);
+    const std::size_t count = 8192;  // ~1 MB
+    ezdxf::benchmark::report_throughput(
+            "hexlify", chunk.size() * count, count, [&chunk]() {
+                for (std::size_t i = 0; i < count; ++i)
+                    ezdxf::utils::hexlify(chunk);
+            });
+    BENCHMARK("hexlify 127 bytes") { return ezdxf::utils::hexlify(chunk); };
+}
+
+TEST_CASE("Unhexlify binary data.", "[benchmark][hexlify]") {
+    auto const hex = ezdxf::utils::hexlify(make_bytes(127));
+    const std::size_t count = 8192;
+    ezdxf::benchmark::report_throughput(
+            "unhexlify", hex.size() * count, count, [&hex]() {
+                for (std::size_t i = 0; i < count; ++i)
+                    ezdxf::utils::unhexlify(hex);
+            });
+    BENCHMARK("unhexlify 254 chars") {
+        return ezdxf::utils::unhexlify(hex);
+    };
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <sstream>
+#include "ezdxf/alloc_counter.hpp"
+#include "ezdxf/ezdxf.hpp"
+#include "corpus.hpp"
+
+using ezdxf::alloc::AllocationCounter;
+using ezdxf::benchmark::CorpusOptions;
+
+// Allocation accounting: the allocation counts are deterministic and are
+// checked in debug builds too, the benchmark tag is used to group them.
+
+static CorpusOptions single_type(const std::string &name) {
+    // Returns options to generate only DXF objects of the given type:
+    auto options = CorpusOptions{1 << 20, 0, 0, 0, 0, 0};
+    if (name == "LINE") options.lines = 1;
+    else if (name == "LWPOLYLINE") options.lwpolylines = 1;
+    else if (name == "TEXT") options.texts = 1;
+    else if (name == "HATCH") options.hatches = 1;
+    else options.binary_objects = 1;
+    return options;
+}
+
+static bool load(ezdxf::Document &doc, const std::string &data,
+                 const ezdxf::LoadOptions &options = {}) {
+    auto basic_loader = ezdxf::tag::BasicLoader(data);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    return doc.load(loader, options);
+}
+
+TEST_CASE("Allocations per DXF object type.", "[benchmark][alloc]") {
+    // Upper bounds of the allocations per object, about half an allocation
+    // above the measured counts, one more allocation per object is a
+    // regression:
+    struct Limit {
+        const char *name;
+        double allocations;
+    };
+    for (auto const limit : {Limit{"LINE", 7.5}, Limit{"LWPOLYLINE", 8.5},
+                             Limit{"TEXT", 9.5}, Limit{"HATCH", 9.5},
+                             Limit{"XRECORD", 24.0}}) {
+        auto const data = ezdxf::benchmark::generate_dxf(
+                single_type(limit.name));
+        auto doc = ezdxf::Document();
+        auto counter = AllocationCounter();
+        REQUIRE(load(doc, data));
+        auto const stats = counter.stats();
+        auto const objects = doc.get_load_stats().objects;
+        REQUIRE(objects > 0);
+        auto const allocations = static_cast<double>(stats.allocations) /
+                                 static_cast<double>(objects);
+        INFO(limit.name << ": " << allocations << " allocations/object, "
+                        << static_cast<double>(stats.bytes) /
+                           static_cast<double>(objects)
+                        << " bytes/object");
+        REQUIRE(allocations <= limit.allocations);
+    }
+}
+
+TEST_CASE("Skipping entities does not allocate per tag.", "[benchmark][alloc]") {
+    // Entities of rejected types are skipped without decoding, the only
+    // allocations are the growth of containers like the skipped handles.
+    auto const data = ezdxf::benchmark::generate_dxf(single_type("LINE"));
+    auto doc = ezdxf::Document();
+    auto options = ezdxf::LoadOptions{{ezdxf::DXFType::Point}};
+    auto counter = AllocationCounter();
+    REQUIRE(load(doc, data, options));
+    auto const stats = counter.stats();
+    auto const entities = doc.get_skipped_handles().size();
+    auto const tags = doc.get_load_stats().tags;
+    std::size_t tag_count = 0;
+    for (auto const count : tags) tag_count += count;
+    REQUIRE(entities > 1000);
+    INFO("allocations: " << stats.allocations << ", tags: " << tag_count);
+    // O(1) per section and O(log n) container growth, a regression to
+    // allocations per entity or per tag exceeds this limit by far:
+    REQUIRE(stats.allocations < 200);
+}
+
+TEST_CASE("Lazy prescan does not allocate per tag.", "[benchmark][alloc]") {
+    // The prescan records the locations of the DXF objects and decodes only
+    // the handles.
+    auto const data = ezdxf::benchmark::generate_dxf(single_type("LINE"));
+    auto stream = std::make_unique<std::istringstream>(data);
+    auto doc = ezdxf::Document();
+    auto counter = AllocationCounter();
+    REQUIRE(doc.load_lazy(std::move(stream)));
+    auto const stats = counter.stats();
+    INFO("allocations: " << stats.allocations);
+    REQUIRE(stats.allocations < 200);
+}
@@ -0,0 +1,169 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <array>
+#include <fstream>
+#include <sstream>
+#include "corpus.hpp"
+
+namespace ezdxf::benchmark {
+    class Random {
+        // SplitMix64: the standard distributions are implementation defined,
+        // this generator returns the same sequence on all platforms.
+    private:
+        uint64_t state_;
+
+    public:
+        explicit Random(uint64_t seed) : state_(seed) {}
+
+        uint64_t next() {
+            uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        unsigned below(unsigned n) {
+            return static_cast<unsigned>(next() % n);
+        }
+
+        int coordinate() {
+            // Returns coordinates in the range [-10000, 10000) as
+            // hundredths, printed with 2 decimal places:
+            return static_cast<int>(next() % 2000000) - 1000000;
+        }
+    };
+
+    static const std::array<const char *, 5> kLayers{
+            "0", "WALLS", "DOORS", "WINDOWS", "TEXT"};
+
+    class CorpusWriter {
+    private:
+        Random random_;
+        std::ostringstream entities_{};
+        std::ostringstream objects_{};
+        uint64_t handle_{0x100};
+
+        void coordinate(std::ostream &out, int code) {
+            int value = random_.coordinate();
+            out << code << "\n";
+            if (value < 0) {
+                out << "-";
+                value = -value;
+            }
+            out << value / 100 << "." << (value % 100) / 10 << value % 10
+                << "\n";
+        }
+
+        void point(std::ostream &out, int code, bool z = true) {
+            coordinate(out, code);
+            coordinate(out, code + 10);
+            if (z) coordinate(out, code + 20);
+        }
+
+        void entity(const char *name) {
+            entities_ << "0\n" << name << "\n5\n" << std::hex
+                      << std::uppercase << handle_++ << std::dec
+                      << "\n330\n1F\n100\nAcDbEntity\n8\n"
+                      << kLayers[random_.below(kLayers.size())] << "\n";
+        }
+
+        void line() {
+            entity("LINE");
+            entities_ << "100\nAcDbLine\n";
+            point(entities_, 10);
+            point(entities_, 11);
+        }
+
+        void lwpolyline() {
+            entity("LWPOLYLINE");
+            const unsigned count = 2 + random_.below(30);
+            entities_ << "100\nAcDbPolyline\n90\n" << count << "\n70\n"
+                      << random_.below(2) << "\n";
+            for (unsigned i = 0; i < count; ++i) point(entities_, 10, false);
+        }
+
+        void text() {
+            entity("TEXT");
+            entities_ << "100\nAcDbText\n";
+            point(entities_, 10);
+            entities_ << "40\n2.5\n1\nText #" << random_.next() << "\n"
+                      << "100\nAcDbText\n";
+        }
+
+        void hatch() {
+            entity("HATCH");
+            const unsigned count = 3 + random_.below(20);
+            entities_ << "100\nAcDbHatch\n10\n0.0\n20\n0.0\n30\n0.0\n"
+                         "210\n0.0\n220\n0.0\n230\n1.0\n2\nSOLID\n70\n1\n"
+                         "71\n0\n91\n1\n92\n2\n72\n0\n73\n1\n93\n"
+                      << count << "\n";
+            for (unsigned i = 0; i < count; ++i) point(entities_, 10, false);
+            entities_ << "97\n0\n75\n0\n76\n1\n98\n0\n";
+        }
+
+        void binary_object() {
+            objects_ << "0\nXRECORD\n5\n" << std::hex << std::uppercase
+                     << handle_++ << std::dec << "\n330\nC\n"
+                     << "100\nAcDbXrecord\n280\n1\n";
+            const unsigned chunks = 1 + random_.below(16);
+            for (unsigned chunk = 0; chunk < chunks; ++chunk) {
+                objects_ << "310\n";
+                // 127 bytes per chunk like AutoCAD:
+                for (unsigned i = 0; i < 127; ++i) {
+                    objects_ << "0123456789ABCDEF"[random_.below(16)]
+                             << "0123456789ABCDEF"[random_.below(16)];
+                }
+                objects_ << "\n";
+            }
+        }
+
+    public:
+        explicit CorpusWriter(uint64_t seed) : random_(seed) {}
+
+        std::string generate(const CorpusOptions &options) {
+            const unsigned total = options.lines + options.lwpolylines +
+                                   options.texts + options.hatches +
+                                   options.binary_objects;
+            std::size_t size = 0;
+            while (total && size < options.size) {
+                unsigned choice = random_.below(total);
+                if (choice < options.lines) line();
+                else if ((choice -= options.lines) < options.lwpolylines)
+                    lwpolyline();
+                else if ((choice -= options.lwpolylines) < options.texts)
+                    text();
+                else if ((choice -= options.texts) < options.hatches)
+                    hatch();
+                else binary_object();
+                // tellp() is cheap for string streams:
+                size = static_cast<std::size_t>(entities_.tellp()) +
+                       static_cast<std::size_t>(objects_.tellp());
+            }
+            std::ostringstream dxf;
+            dxf << "0\nSECTION\n2\nHEADER\n9\n$ACADVER\n1\nAC1024\n"
+                   "9\n$HANDSEED\n5\n" << std::hex << std::uppercase
+                << handle_ << std::dec << "\n0\nENDSEC\n"
+                << "0\nSECTION\n2\nTABLES\n"
+                   "0\nTABLE\n2\nBLOCK_RECORD\n5\n1\n"
+                   "0\nBLOCK_RECORD\n5\n1F\n330\n1\n2\n*Model_Space\n"
+                   "0\nENDTAB\n5\n2\n0\nENDSEC\n"
+                << "0\nSECTION\n2\nENTITIES\n" << entities_.str()
+                << "0\nENDSEC\n"
+                << "0\nSECTION\n2\nOBJECTS\n"
+                   "0\nDICTIONARY\n5\nC\n330\n0\n"
+                << objects_.str() << "0\nENDSEC\n0\nEOF\n";
+            return dxf.str();
+        }
+    };
+
+    std::string generate_dxf(const CorpusOptions &options) {
+        return CorpusWriter(options.seed).generate(options);
+    }
+
+    bool write_dxf(const std::string &filename, const CorpusOptions &options) {
+        auto stream = std::ofstream(filename, std::ios::binary);
+        stream << generate_dxf(options);
+        return static_cast<bool>(stream);
+    }
+}
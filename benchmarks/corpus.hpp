@@ -0,0 +1,33 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_BENCHMARKS_CORPUS_HPP
+#define EZDXF_BENCHMARKS_CORPUS_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace ezdxf::benchmark {
+    struct CorpusOptions {
+        // Approximated size of the generated DXF data in bytes:
+        std::size_t size = 1 << 20;
+        // Relative frequencies of the generated DXF objects, binary objects
+        // are XRECORD objects with binary data tags:
+        unsigned lines = 4;
+        unsigned lwpolylines = 2;
+        unsigned texts = 2;
+        unsigned hatches = 1;
+        unsigned binary_objects = 1;
+        // The same seed generates the same DXF data on all platforms:
+        uint64_t seed = 1;
+    };
+
+    // Returns a valid DXF document as string:
+    std::string generate_dxf(const CorpusOptions &options);
+
+    // Writes a valid DXF document to a file, returns false if the file
+    // could not be written:
+    bool write_dxf(const std::string &filename, const CorpusOptions &options);
+}
+
+#endif //EZDXF_BENCHMARKS_CORPUS_HPP
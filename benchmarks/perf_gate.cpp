@@ -0,0 +1,279 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+// Performance regression gate:
+// Measures throughput, allocations and peak memory usage for the synthetic
+// DXF corpus, writes the results as JSON and compares them against a
+// baseline, the exit code is 1 for regressions.
+//
+// Usage: run_perf_gate [--baseline FILE] [--output FILE]
+//
+// Use the output of an optimized build (CMAKE_BUILD_TYPE=Release) as new
+// baseline: run_perf_gate --output benchmarks/perf_baseline.json
+// Timing and memory metrics depend on the machine and are only compared in
+// optimized builds, allocation counts are compared in all builds.
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+#include "ezdxf/alloc_counter.hpp"
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/utils.hpp"
+#include "corpus.hpp"
+#include "throughput.hpp"
+#include "workloads.hpp"
+
+using namespace ezdxf::benchmark;
+
+// Default tolerances as fraction of the baseline value:
+const double kTimingTolerance = 0.35;
+const double kAllocationTolerance = 0.02;
+const double kMemoryTolerance = 0.25;
+
+#if defined(NDEBUG)
+const bool kOptimizedBuild = true;
+#else
+const bool kOptimizedBuild = false;
+#endif
+
+struct Metric {
+    std::string name;
+    double value;
+    double tolerance;
+    bool higher_is_better;
+    bool machine_dependent;  // compare only optimized builds
+};
+
+using Baseline = std::map<std::string, std::map<std::string, double>>;
+
+class JsonReader {
+    // Minimal reader for the baseline format: an object of metric objects
+    // with number values, e.g. {"name": {"value": 1.0, "tolerance": 0.1}}
+private:
+    const std::string &s_;
+    std::size_t pos_{0};
+
+    void skip_whitespace() {
+        while (pos_ < s_.size() && std::isspace(
+                static_cast<unsigned char>(s_[pos_])))
+            ++pos_;
+    }
+
+    bool expect(char c) {
+        skip_whitespace();
+        if (pos_ < s_.size() && s_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    std::optional<std::string> string() {
+        if (!expect('"')) return {};
+        std::string result;
+        while (pos_ < s_.size() && s_[pos_] != '"') {
+            if (s_[pos_] == '\\') ++pos_;
+            if (pos_ < s_.size()) result += s_[pos_++];
+        }
+        if (!expect('"')) return {};
+        return result;
+    }
+
+    std::optional<double> number() {
+        skip_whitespace();
+        const char *begin = s_.c_str() + pos_;
+        char *end = nullptr;
+        double value = std::strtod(begin, &end);
+        if (end == begin) return {};
+        pos_ += end - begin;
+        return value;
+    }
+
+    template<typename Function>
+    bool members(Function fn) {
+        // Calls fn(key) for all members of an object.
+        if (!expect('{')) return false;
+        if (expect('}')) return true;
+        do {
+            auto key = string();
+            if (!key || !expect(':') || !fn(*key)) return false;
+        } while (expect(','));
+        return expect('}');
+    }
+
+public:
+    explicit JsonReader(const std::string &s) : s_(s) {}
+
+    std::optional<Baseline> read() {
+        Baseline baseline;
+        bool ok = members([this, &baseline](const std::string &name) {
+            auto &metric = baseline[name];
+            return members([this, &metric](const std::string &key) {
+                auto value = number();
+                if (value) metric[key] = *value;
+                return value.has_value();
+            });
+        });
+        if (!ok) return {};
+        return baseline;
+    }
+};
+
+static double peak_rss_mb() {
+    // Returns 0 if not supported.
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.0;
+#if defined(__APPLE__)
+    return static_cast<double>(usage.ru_maxrss) / 1e6;  // bytes
+#else
+    return static_cast<double>(usage.ru_maxrss) / 1e3;  // kilobytes
+#endif
+#else
+    return 0.0;
+#endif
+}
+
+static std::vector<Metric> measure() {
+    auto const data = generate_dxf(CorpusOptions{4 << 20});
+    auto const mb = static_cast<double>(data.size()) / 1e6;
+    auto metrics = std::vector<Metric>{};
+    auto throughput = [&](const char *name, auto fn) {
+        metrics.push_back(Metric{name, mb / measure_seconds(fn),
+                                 kTimingTolerance, true, true});
+    };
+    throughput("basic_loader_mb_s", [&data]() { load_string_tags(data); });
+    throughput("asc_loader_typed_mb_s", [&data]() { load_typed_tags(data); });
+    throughput("document_load_mb_s", [&data]() { load_document(data); });
+
+    auto const chunk = ezdxf::Bytes(127, 0xA5);
+    auto const hex = ezdxf::utils::hexlify(chunk);
+    const std::size_t count = 8192;
+    auto const chunk_mb = static_cast<double>(chunk.size() * count) / 1e6;
+    metrics.push_back(Metric{
+            "hexlify_mb_s", chunk_mb / measure_seconds([&chunk]() {
+                for (std::size_t i = 0; i < count; ++i)
+                    ezdxf::utils::hexlify(chunk);
+            }), kTimingTolerance, true, true});
+    metrics.push_back(Metric{
+            "unhexlify_mb_s", 2 * chunk_mb / measure_seconds([&hex]() {
+                for (std::size_t i = 0; i < count; ++i)
+                    ezdxf::utils::unhexlify(hex);
+            }), kTimingTolerance, true, true});
+
+    {
+        auto doc = ezdxf::Document();
+        auto basic_loader = ezdxf::tag::BasicLoader(data);
+        auto loader = ezdxf::tag::AscLoader(basic_loader);
+        auto counter = ezdxf::alloc::AllocationCounter();
+        doc.load(loader);
+        auto const stats = counter.stats();
+        auto const objects = static_cast<double>(
+                std::max<std::size_t>(1, doc.get_load_stats().objects));
+        metrics.push_back(Metric{
+                "document_load_allocations_per_object",
+                static_cast<double>(stats.allocations) / objects,
+                kAllocationTolerance, false, false});
+        metrics.push_back(Metric{
+                "document_load_bytes_per_object",
+                static_cast<double>(stats.bytes) / objects,
+                kAllocationTolerance, false, false});
+    }
+    metrics.push_back(Metric{"peak_rss_mb", peak_rss_mb(), kMemoryTolerance,
+                             false, true});
+    return metrics;
+}
+
+static bool write_results(const std::string &filename,
+                          const std::vector<Metric> &metrics) {
+    auto stream = std::ofstream(filename);
+    stream << std::setprecision(6) << "{\n";
+    for (std::size_t i = 0; i < metrics.size(); ++i) {
+        auto const &metric = metrics[i];
+        stream << "  \"" << metric.name << "\": {\"value\": " << metric.value
+               << ", \"tolerance\": " << metric.tolerance << "}"
+               << (i + 1 < metrics.size() ? ",\n" : "\n");
+    }
+    stream << "}\n";
+    return static_cast<bool>(stream);
+}
+
+static bool compare(std::vector<Metric> &metrics, const Baseline &baseline) {
+    // Returns false for regressions. The tolerance of the baseline replaces
+    // the default tolerance.
+    bool passed = true;
+    std::cout << std::fixed << std::setprecision(2);
+    for (auto &metric : metrics) {
+        std::cout << std::left << std::setw(40) << metric.name
+                  << std::right << std::setw(12) << metric.value;
+        auto it = baseline.find(metric.name);
+        if (it == baseline.end() || !it->second.count("value")) {
+            std::cout << "  new metric\n";
+            continue;
+        }
+        auto const &values = it->second;
+        const double expected = values.at("value");
+        if (values.count("tolerance")) metric.tolerance = values.at("tolerance");
+        std::cout << std::setw(12) << expected;
+        if ((metric.machine_dependent && !kOptimizedBuild) ||
+            metric.value == 0.0) {
+            std::cout << "  not compared\n";
+            continue;
+        }
+        const bool regression = metric.higher_is_better
+                                ? metric.value <
+                                  expected * (1.0 - metric.tolerance)
+                                : metric.value >
+                                  expected * (1.0 + metric.tolerance);
+        std::cout << (regression ? "  REGRESSION\n" : "  ok\n");
+        if (regression) passed = false;
+    }
+    return passed;
+}
+
+int main(int argc, char *argv[]) {
+    std::string baseline_filename;
+    std::string output_filename;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--baseline" && i + 1 < argc) baseline_filename = argv[++i];
+        else if (arg == "--output" && i + 1 < argc) output_filename = argv[++i];
+        else {
+            std::cerr << "usage: run_perf_gate [--baseline FILE] "
+                         "[--output FILE]\n";
+            return 2;
+        }
+    }
+    auto baseline = Baseline{};
+    if (!baseline_filename.empty()) {
+        auto stream = std::ifstream(baseline_filename);
+        auto content = std::ostringstream{};
+        content << stream.rdbuf();
+        auto result = JsonReader(content.str()).read();
+        if (!stream || !result) {
+            std::cerr << "invalid baseline file: " << baseline_filename
+                      << "\n";
+            return 2;
+        }
+        baseline = std::move(*result);
+    }
+    if (!kOptimizedBuild)
+        std::cout << "Debug build: timing and memory are not compared!\n";
+    auto metrics = measure();
+    const bool passed = compare(metrics, baseline);
+    if (!output_filename.empty() && !write_results(output_filename, metrics)) {
+        std::cerr << "cannot write results: " << output_filename << "\n";
+        return 2;
+    }
+    std::cout << (passed ? "PASSED\n" : "FAILED\n");
+    return passed ? 0 : 1;
+}
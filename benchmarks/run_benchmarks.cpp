@@ -0,0 +1,10 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+// Benchmarks require an optimized build: cmake -DCMAKE_BUILD_TYPE=Release
+// Each benchmark has an unique name, guaranteed by an alpha numerical prefix:
+// e.g. b01_loader.cpp, b02_hexlify.cpp, ...
@@ -0,0 +1,50 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_BENCHMARKS_THROUGHPUT_HPP
+#define EZDXF_BENCHMARKS_THROUGHPUT_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace ezdxf::benchmark {
+    // Count of runs to measure the throughput, the fastest run is reported:
+    const int kThroughputRuns = 5;
+
+    template<typename Function>
+    double measure_seconds(Function fn) {
+        // Returns the seconds of the fastest of kThroughputRuns runs.
+        double best = 0.0;
+        for (int run = 0; run < kThroughputRuns; ++run) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            std::chrono::duration<double> seconds =
+                    std::chrono::steady_clock::now() - start;
+            best = run ? std::min(best, seconds.count()) : seconds.count();
+        }
+        return std::max(best, 1e-9);
+    }
+
+    template<typename Function>
+    double report_throughput(const std::string &name, std::size_t bytes,
+                             std::size_t tags, Function fn) {
+        // Catch2 benchmarks report only the time per run, this function
+        // prints the throughput of the fastest run in MB/s and tags/s, tags
+        // are not reported if the count is 0.
+        // Returns the throughput in MB/s.
+        const double best = measure_seconds(fn);
+        const double mb_per_second = static_cast<double>(bytes) / 1e6 / best;
+        std::cout << std::fixed << std::setprecision(1) << name << ": "
+                  << mb_per_second << " MB/s";
+        if (tags)
+            std::cout << ", " << static_cast<double>(tags) / best / 1e6
+                      << " Mtags/s";
+        std::cout << std::endl;
+        return mb_per_second;
+    }
+}
+
+#endif //EZDXF_BENCHMARKS_THROUGHPUT_HPP
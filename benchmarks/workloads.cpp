@@ -0,0 +1,55 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include "ezdxf/ezdxf.hpp"
+#include "workloads.hpp"
+
+namespace ezdxf::benchmark {
+    using ezdxf::tag::TagType;
+
+    std::size_t load_string_tags(const std::string &data) {
+        auto loader = ezdxf::tag::BasicLoader(data);
+        std::size_t count = 0;
+        while (!loader.is_empty()) {
+            loader.get();
+            ++count;
+        }
+        return count;
+    }
+
+    std::size_t load_typed_tags(const std::string &data) {
+        auto basic_loader = ezdxf::tag::BasicLoader(data);
+        auto loader = ezdxf::tag::AscLoader(basic_loader);
+        std::size_t count = 0;
+        while (!loader.eof()) {
+            std::unique_ptr<ezdxf::tag::DXFTag> tag;
+            switch (loader.detect_current_type()) {
+                case TagType::kInteger:
+                    tag = loader.integer_tag();
+                    break;
+                case TagType::kReal:
+                    tag = loader.real_tag();
+                    break;
+                case TagType::kVec3:
+                    tag = loader.vec3_tag();
+                    break;
+                case TagType::kBinaryData:
+                    tag = loader.binary_tag();
+                    break;
+                default:
+                    tag = loader.string_tag();
+            }
+            if (tag->is_error_tag()) loader.skip();  // skip invalid tag
+            ++count;
+        }
+        return count;
+    }
+
+    std::size_t load_document(const std::string &data) {
+        auto basic_loader = ezdxf::tag::BasicLoader(data);
+        auto loader = ezdxf::tag::AscLoader(basic_loader);
+        auto doc = ezdxf::Document();
+        doc.load(loader);
+        return doc.get_object_table().size();
+    }
+}
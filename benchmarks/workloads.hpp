@@ -0,0 +1,23 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_BENCHMARKS_WORKLOADS_HPP
+#define EZDXF_BENCHMARKS_WORKLOADS_HPP
+
+#include <string>
+
+// Workloads shared by the benchmarks and the performance gate, each function
+// loads the DXF data completely.
+
+namespace ezdxf::benchmark {
+    // Returns the count of loaded string tags:
+    std::size_t load_string_tags(const std::string &data);
+
+    // Returns the count of typed tags, vectors are a single tag:
+    std::size_t load_typed_tags(const std::string &data);
+
+    // Returns the count of loaded DXF objects:
+    std::size_t load_document(const std::string &data);
+}
+
+#endif //EZDXF_BENCHMARKS_WORKLOADS_HPP
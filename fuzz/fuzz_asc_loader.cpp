@@ -0,0 +1,71 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <cstdint>
+#include <string>
+#include "ezdxf/tag/loader.hpp"
+#include "fuzz_budget.hpp"
+
+using ezdxf::tag::AscLoader;
+using ezdxf::tag::DXFTag;
+using ezdxf::tag::TagType;
+
+static std::unique_ptr<DXFTag> typed_tag(AscLoader &loader) {
+    // Loads the current tag by the getter of its group code type.
+    switch (loader.detect_current_type()) {
+        case TagType::kInteger:
+            return loader.integer_tag();
+        case TagType::kReal:
+            return loader.real_tag();
+        case TagType::kVec3:
+            return loader.vec3_tag();
+        case TagType::kBinaryData:
+            return loader.binary_tag();
+        default:
+            return loader.string_tag();
+    }
+}
+
+static std::unique_ptr<DXFTag> any_tag(AscLoader &loader, unsigned choice) {
+    // Calls the getters regardless of the group code type, which tests the
+    // error handling of the getters.
+    switch (choice % 6) {
+        case 0:
+            return loader.integer_tag();
+        case 1:
+            return loader.real_tag();
+        case 2:
+            return loader.vec3_tag();
+        case 3:
+            return loader.binary_tag();
+        case 4:
+            return typed_tag(loader);
+        default:
+            return loader.string_tag();
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, std::size_t size) {
+    // The first byte selects the getters: even values use the getters of the
+    // group code types, odd values rotate through all getters.
+    if (size == 0) return 0;
+    auto const budget = ezdxf::fuzz::TimeBudget(size);
+    const unsigned mode = data[0];
+    auto basic_loader = ezdxf::tag::BasicLoader(
+            std::string(reinterpret_cast<const char *>(data + 1), size - 1));
+    auto loader = AscLoader(basic_loader);
+    unsigned choice = mode;
+    while (!loader.eof()) {
+        auto const line_number = loader.get_line_number();
+        auto tag = mode & 1 ? any_tag(loader, choice++) : typed_tag(loader);
+        if (tag->is_error_tag()) {
+            // The getters do not skip invalid tags:
+            if (loader.get_line_number() == line_number) loader.skip();
+            continue;
+        }
+        // Access the typed values:
+        if (tag->has_vec3_value()) tag->vec3();
+        else if (tag->type() == TagType::kBinaryData) tag->bytes();
+    }
+    return 0;
+}
@@ -0,0 +1,21 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <cstdint>
+#include <string>
+#include "ezdxf/tag/loader.hpp"
+#include "fuzz_budget.hpp"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, std::size_t size) {
+    auto const budget = ezdxf::fuzz::TimeBudget(size);
+    auto loader = ezdxf::tag::BasicLoader(
+            std::string(reinterpret_cast<const char *>(data), size));
+    std::size_t offset = 0;
+    while (!loader.is_empty()) {
+        loader.get();
+        // Offsets are increasing, the loader has to make progress:
+        if (loader.get_offset() <= offset && !loader.is_empty()) __builtin_trap();
+        offset = loader.get_offset();
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_FUZZ_BUDGET_HPP
+#define EZDXF_FUZZ_BUDGET_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace ezdxf::fuzz {
+    // Time budget per input: a fixed base time plus a time per input byte.
+    // The loaders are linear in the input size, inputs which exceed the
+    // budget reveal super-linear behavior and are reported as findings.
+    // Instrumented builds are slower, the environment variable
+    // EZDXF_FUZZ_BUDGET_FACTOR scales the budget, e.g. "10".
+    const double kBaseBudgetMilliseconds = 50.0;
+    const double kBudgetMicrosecondsPerByte = 2.0;
+
+    inline double budget_factor() {
+        static const double factor = []() {
+            const char *value = std::getenv("EZDXF_FUZZ_BUDGET_FACTOR");
+            double result = value ? std::atof(value) : 1.0;
+            return result > 0.0 ? result : 1.0;
+        }();
+        return factor;
+    }
+
+    class TimeBudget {
+        // Aborts at the end of its lifetime if the processing time exceeded
+        // the budget for the input size, libFuzzer and AFL store the input
+        // as crash.
+    private:
+        std::chrono::steady_clock::time_point start_;
+        double budget_ms_;
+
+    public:
+        explicit TimeBudget(std::size_t size) :
+                start_(std::chrono::steady_clock::now()),
+                budget_ms_((kBaseBudgetMilliseconds +
+                            kBudgetMicrosecondsPerByte *
+                            static_cast<double>(size) / 1000.0) *
+                           budget_factor()) {}
+
+        ~TimeBudget() {
+            const double elapsed_ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start_).count();
+            if (elapsed_ms > budget_ms_) {
+                std::fprintf(stderr, "ezdxf fuzz: slow input, %.1f ms "
+                                     "exceeds the budget of %.1f ms\n",
+                             elapsed_ms, budget_ms_);
+                std::abort();
+            }
+        }
+
+        TimeBudget(const TimeBudget &) = delete;
+
+        TimeBudget &operator=(const TimeBudget &) = delete;
+    };
+}
+
+#endif //EZDXF_FUZZ_BUDGET_HPP
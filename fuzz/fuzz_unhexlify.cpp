@@ -0,0 +1,20 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <cstdint>
+#include <string>
+#include "ezdxf/utils.hpp"
+#include "fuzz_budget.hpp"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, std::size_t size) {
+    auto const budget = ezdxf::fuzz::TimeBudget(size);
+    auto const s = std::string(reinterpret_cast<const char *>(data), size);
+    auto const bytes = ezdxf::utils::unhexlify(s);
+    if (bytes) {
+        // Valid hex strings have to round trip, case insensitive:
+        auto const hex = ezdxf::utils::hexlify(*bytes);
+        auto const again = ezdxf::utils::unhexlify(hex);
+        if (!again || *again != *bytes) __builtin_trap();
+    }
+    return 0;
+}
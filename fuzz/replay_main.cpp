@@ -0,0 +1,41 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+// Replay driver for builds without libFuzzer: runs the fuzz target for all
+// given files and all files of given directories, e.g. a fuzzing corpus or
+// crash files. Also usable as AFL target: afl-fuzz ... -- fuzz_replay @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, std::size_t size);
+
+static void replay(const std::filesystem::path &path) {
+    auto stream = std::ifstream(path, std::ios::binary);
+    auto data = std::vector<uint8_t>(std::istreambuf_iterator<char>(stream),
+                                     std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+}
+
+int main(int argc, char *argv[]) {
+    namespace fs = std::filesystem;
+    std::size_t count = 0;
+    for (int i = 1; i < argc; ++i) {
+        const fs::path path = argv[i];
+        if (fs::is_directory(path)) {
+            for (auto const &entry : fs::recursive_directory_iterator(path)) {
+                if (!entry.is_regular_file()) continue;
+                replay(entry.path());
+                ++count;
+            }
+        } else {
+            replay(path);
+            ++count;
+        }
+    }
+    std::cout << "replayed " << count << " inputs" << std::endl;
+    return 0;
+}
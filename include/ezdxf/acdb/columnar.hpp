@@ -0,0 +1,61 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_COLUMNAR_HPP
+#define EZDXF_COLUMNAR_HPP
+
+#include <array>
+#include <cstdint>
+#include "ezdxf/type.hpp"
+#include "ezdxf/geometry_store.hpp"
+#include "ezdxf/acdb/entity.hpp"
+
+namespace ezdxf::acdb {
+
+    // acdb::ColumnarEntity is a LINE, POINT, CIRCLE or ARC entity, which
+    // stores its geometry in a row of the GeometryColumns owned by the
+    // document, the entity stores only the row index. The geometry tags are
+    // not stored as raw tags, all other tags are preserved as raw tags and
+    // the geometry tags are exported at their original position.
+    class ColumnarEntity : public Entity {
+        friend class ezdxf::GeometryColumns;
+
+    public:
+        using Positions = std::array<uint32_t, kMaxGeometryGroups>;
+
+    private:
+        GeometryColumns *columns_;
+        std::size_t row_;
+        // Position of the geometry tag groups in the raw tags:
+        Positions positions_;
+
+        void set_row(std::size_t row) { row_ = row; }
+
+    protected:
+        void export_decoded_tags(tag::AscWriter &writer,
+                                 std::size_t index) const override;
+
+    public:
+        // Moves the entity without the geometry tags, which are stored in
+        // the given row of the columns:
+        ColumnarEntity(Entity &&entity, tag::StringTags tags,
+                       GeometryColumns &columns, std::size_t row,
+                       const Positions &positions);
+
+        [[nodiscard]] std::size_t row() const { return row_; }
+
+        [[nodiscard]] const GeometryColumns &columns() const {
+            return *columns_;
+        }
+
+        // Returns the value of the geometry tag with the given group code,
+        // throws std::invalid_argument for other group codes:
+        [[nodiscard]] Real value(int code) const;
+
+        void set_value(int code, Real value);
+
+        void for_each_tag(const std::function<void(const tag::StringTag &)>
+                          &fn) const override;
+    };
+}
+#endif //EZDXF_COLUMNAR_HPP
@@ -0,0 +1,120 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_ENTITY_HPP
+#define EZDXF_ENTITY_HPP
+
+#include <functional>
+#include <utility>
+#include "ezdxf/type.hpp"
+#include "ezdxf/acdb/object.hpp"
+#include "ezdxf/tag/tag.hpp"
+
+namespace ezdxf::acdb {
+    // Upper limit for presizing arrays by the count tags of loaded objects,
+    // count tags are not trustworthy and bigger arrays grow on demand:
+    const std::size_t kMaxPresize = std::size_t(1) << 20;
+
+    // acdb::RawObject stores a loaded DXF object as raw DXF tags.
+    // Only the handle, the owner handle and the pointer references are
+    // decoded, all other data is preserved as loaded, which is the storage
+    // for DXF objects without a specialized class.
+    class RawObject : public Object {
+    private:
+        String name_;  // DXF type as string e.g. "LINE", "DICTIONARY"
+        // All tags of the DXF object without the leading structure tag
+        // (0, name) in the original order:
+        tag::StringTags tags_{};
+        bool loaded_{false};  // object was loaded from a DXF file
+
+    protected:
+        // Export the required tags of new objects which were not loaded
+        // from a DXF file:
+        virtual void export_new_object_tags(tag::AscWriter &writer) const;
+
+        // Export a raw tag which is not a handle or the owner handle,
+        // subclasses can replace the raw tag by the current value:
+        virtual void export_raw_tag(tag::AscWriter &writer,
+                                    const tag::StringTag &tag) const;
+
+        // Export the decoded data of subclasses, which is not stored as raw
+        // tags, in front of the raw tag at the given index. The index is
+        // the count of raw tags to export decoded data at the end of the
+        // object:
+        virtual void export_decoded_tags(tag::AscWriter & /*writer*/,
+                                         std::size_t /*index*/) const {}
+
+    public:
+        explicit RawObject(String name) : name_(std::move(name)) {}
+
+        // Exports the raw tags and replaces the handle and the owner handle
+        // by the current values:
+        void export_dxf(tag::AscWriter &writer) const override;
+
+        [[nodiscard]] bool is_loaded() const { return loaded_; }
+
+        [[nodiscard]] const String &get_name() const { return name_; }
+
+        [[nodiscard]] const tag::StringTags &get_raw_tags() const {
+            return tags_;
+        }
+
+        void set_raw_tags(tag::StringTags tags) {
+            tags_ = std::move(tags);
+            loaded_ = true;
+        }
+
+        // Set all loaded tags, subclasses decode their specialized data and
+        // store the remaining tags as raw tags. Invalid values are logged
+        // in errors for the given line number:
+        virtual void load_tags(tag::StringTags tags,
+                               ErrorMessages & /*errors*/,
+                               std::size_t /*line_number*/) {
+            set_raw_tags(std::move(tags));
+        }
+
+        // Calls fn(tag) for all tags in the loaded order, subclasses pass
+        // their decoded data as rebuilt tags, load_tags() restores the
+        // object from these tags:
+        virtual void for_each_tag(
+                const std::function<void(const tag::StringTag &)> &fn) const {
+            for (auto const &tag : tags_) fn(tag);
+        }
+
+        // Returns the first raw tag with the given group code or nullptr:
+        [[nodiscard]] const tag::StringTag *find_raw_tag(int code) const {
+            for (auto const &tag : tags_) {
+                if (tag.group_code() == code) return &tag;
+            }
+            return nullptr;
+        }
+    };
+
+    // acdb::Entity is the base class for all graphical DXF entities.
+    class Entity : public RawObject {
+    private:
+        DXFType type_;
+        String layer_{"0"};
+
+    protected:
+        void export_new_object_tags(tag::AscWriter &writer) const override;
+
+        void export_raw_tag(tag::AscWriter &writer,
+                            const tag::StringTag &tag) const override;
+
+    public:
+        Entity(DXFType type, String name) :
+                RawObject(std::move(name)), type_(type) {}
+
+        [[nodiscard]] DXFType dxf_type() const override { return type_; }
+
+        [[nodiscard]] ARXType arx_type() const override {
+            return ARXType::AcDbEntity;
+        }
+
+        [[nodiscard]] const String &get_layer() const { return layer_; }
+
+        void set_layer(String layer) { layer_ = std::move(layer); }
+    };
+}
+#endif //EZDXF_ENTITY_HPP
@@ -0,0 +1,33 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_FACTORY_HPP
+#define EZDXF_FACTORY_HPP
+
+#include <memory>
+#include "ezdxf/type.hpp"
+#include "ezdxf/acdb/object.hpp"
+#include "ezdxf/tag/loader.hpp"
+
+namespace ezdxf::acdb {
+    // Load the next DXF object from the loader, starting at the structure
+    // tag (0, name) and ending in front of the next structure tag.
+    //
+    // Returns the specialized class (e.g. acdb::LwPolyline) or an
+    // acdb::Entity for all DXF types defined by the DXFType enum, else an
+    // acdb::RawObject. An object without a handle (or an invalid handle)
+    // has the handle 0, invalid handles are logged in errors.
+    //
+    // An acdb::Polyline includes the following VERTEX and SEQEND entities.
+    std::unique_ptr<Object> load_object(tag::AscLoader &loader,
+                                        ErrorMessages &errors);
+
+    // Create a DXF object from already loaded tags without the leading
+    // structure tag (0, name), errors are logged for the line number of
+    // the structure tag.
+    std::unique_ptr<Object> load_object(const String &name,
+                                        tag::StringTags tags,
+                                        ErrorMessages &errors,
+                                        std::size_t line_number);
+}
+#endif //EZDXF_FACTORY_HPP
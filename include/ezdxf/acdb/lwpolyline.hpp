@@ -0,0 +1,111 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_LWPOLYLINE_HPP
+#define EZDXF_LWPOLYLINE_HPP
+
+#include <vector>
+#include "ezdxf/type.hpp"
+#include "ezdxf/acdb/entity.hpp"
+#include "ezdxf/tag/loader.hpp"
+
+namespace ezdxf::acdb {
+
+    // acdb::LwPolyline stores the vertices of a LWPOLYLINE entity as
+    // contiguous arrays, one array for each vertex attribute (structure of
+    // arrays). The vertex tags (10, 20, 40, 41, 42, 91) are decoded into
+    // these arrays, all other tags are preserved as raw tags.
+    //
+    // The start width, end width, bulge and identifier arrays are optional
+    // and allocated for the first value != 0, an empty array represents 0
+    // for all vertices.
+    class LwPolyline : public Entity {
+    private:
+        std::vector<Real> x_{};
+        std::vector<Real> y_{};
+        // Optional arrays:
+        std::vector<Real> start_width_{};
+        std::vector<Real> end_width_{};
+        std::vector<Real> bulge_{};
+        // Vertex identifiers (91) of DXF R2010+, empty if not present:
+        std::vector<int64_t> identifiers_{};
+        // Position of the vertex tags in the raw tags:
+        std::size_t vertex_tags_index_{0};
+
+        // Decodes a single vertex tag, the group code 10 starts a new
+        // vertex, all other vertex tags modify the last vertex.
+        // Returns false for invalid values, which are stored as 0.
+        bool load_vertex_tag(int code, const String &value);
+
+        // Calls fn(tag) for the rebuilt tags of the vertex at index:
+        void for_each_vertex_tag(
+                std::size_t index,
+                const std::function<void(const tag::StringTag &)> &fn) const;
+
+    protected:
+        void export_new_object_tags(tag::AscWriter &writer) const override;
+
+        // Replaces the vertex count (90) by the current count of vertices:
+        void export_raw_tag(tag::AscWriter &writer,
+                            const tag::StringTag &tag) const override;
+
+        void export_decoded_tags(tag::AscWriter &writer,
+                                 std::size_t index) const override;
+
+    public:
+        LwPolyline() : Entity(DXFType::LwPolyline, "LWPOLYLINE") {}
+
+        static bool is_vertex_group_code(int code) {
+            return code == 10 || code == 20 || code == 40 || code == 41 ||
+                   code == 42 || code == 91;
+        }
+
+        [[nodiscard]] std::size_t size() const { return x_.size(); }
+
+        [[nodiscard]] const std::vector<Real> &x() const { return x_; }
+
+        [[nodiscard]] const std::vector<Real> &y() const { return y_; }
+
+        [[nodiscard]] const std::vector<Real> &start_width() const {
+            return start_width_;
+        }
+
+        [[nodiscard]] const std::vector<Real> &end_width() const {
+            return end_width_;
+        }
+
+        [[nodiscard]] const std::vector<Real> &bulge() const {
+            return bulge_;
+        }
+
+        [[nodiscard]] const std::vector<int64_t> &identifiers() const {
+            return identifiers_;
+        }
+
+        void reserve(std::size_t count);
+
+        // Presize the vertex arrays by the value of the vertex count tag
+        // (90), limited to kMaxPresize vertices:
+        void presize(const String &count);
+
+        void clear();
+
+        void append(Real x, Real y, Real start_width = 0.0,
+                    Real end_width = 0.0, Real bulge = 0.0);
+
+        // Bulk loader for the vertex tags: decodes all consecutive vertex
+        // tags of the loader without creating typed tags. The vertex tags
+        // are exported in front of the raw tag at index tags_index.
+        void load_vertices(tag::AscLoader &loader, std::size_t tags_index,
+                           ErrorMessages &errors);
+
+        // Decodes the vertex tags starting at the first group code 10 and
+        // stores all other tags as raw tags:
+        void load_tags(tag::StringTags tags, ErrorMessages &errors,
+                       std::size_t line_number) override;
+
+        void for_each_tag(const std::function<void(const tag::StringTag &)>
+                          &fn) const override;
+    };
+}
+#endif //EZDXF_LWPOLYLINE_HPP
@@ -0,0 +1,107 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_MESH_HPP
+#define EZDXF_MESH_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "ezdxf/type.hpp"
+#include "ezdxf/span.hpp"
+#include "ezdxf/acdb/entity.hpp"
+#include "ezdxf/tag/loader.hpp"
+
+namespace ezdxf::acdb {
+
+    // acdb::Mesh stores the geometry of a MESH entity in flat buffers: the
+    // vertices as (x, y, z) triples, the face list as stored in the DXF
+    // file (vertex count followed by the vertex indices of each face), the
+    // edges as vertex index pairs and the crease values of the edges.
+    //
+    // Each data block is a count tag followed by the values, e.g. the
+    // vertex count (92) followed by the vertices (10, 20, 30). The buffers
+    // are presized by the count tags and the values are decoded in bulk,
+    // all other tags are preserved as raw tags.
+    class Mesh : public Entity {
+    public:
+        enum Block {
+            kVertices,  // (92, count) (10, x) (20, y) (30, z) ...
+            kFaces,  // (93, size) (90, index) ...
+            kEdges,  // (94, count) (90, index) ...
+            kCreases,  // (95, count) (140, value) ...
+            kBlockCount,
+        };
+
+    private:
+        std::vector<Real> vertices_{};
+        std::vector<int32_t> faces_{};
+        std::vector<int32_t> edges_{};
+        std::vector<Real> creases_{};
+        // Position of the data blocks in the raw tags, new entities export
+        // all blocks after the required tags and loaded entities do not
+        // export missing blocks:
+        std::array<std::size_t, kBlockCount> block_index_{
+                SIZE_MAX, SIZE_MAX, SIZE_MAX, SIZE_MAX};
+        // The blocks are decoded in the order of the Block enum, a block is
+        // decoded only once, because the override data after the creases
+        // contains the same group codes:
+        int next_block_{kVertices};
+
+        template<typename Source>
+        void decode_block(Source &source, ErrorMessages &errors);
+
+        // Calls fn(tag) for the rebuilt tags of a data block:
+        void for_each_block_tag(
+                Block block,
+                const std::function<void(const tag::StringTag &)> &fn) const;
+
+    protected:
+        void export_new_object_tags(tag::AscWriter &writer) const override;
+
+        void export_decoded_tags(tag::AscWriter &writer,
+                                 std::size_t index) const override;
+
+    public:
+        Mesh() : Entity(DXFType::Mesh, "MESH") {}
+
+        // Returns true if the current tag of a MESH entity starts the next
+        // data block, the subclass marker (100, AcDbSubDMesh) has to be
+        // loaded:
+        [[nodiscard]] bool is_next_block(int code) const;
+
+        [[nodiscard]] std::size_t vertex_count() const {
+            return vertices_.size() / 3;
+        }
+
+        // Flat vertex buffer: x0, y0, z0, x1, y1, z1, ...
+        [[nodiscard]] Span<Real> vertices() const { return Span(vertices_); }
+
+        // Face list: count, index, index, ..., count, index, ...
+        [[nodiscard]] Span<int32_t> face_list() const {
+            return Span(faces_);
+        }
+
+        // Edges as vertex index pairs:
+        [[nodiscard]] Span<int32_t> edges() const { return Span(edges_); }
+
+        [[nodiscard]] Span<Real> creases() const { return Span(creases_); }
+
+        void append_vertex(Real x, Real y, Real z);
+
+        void append_face(Span<int32_t> indices);
+
+        // Bulk loader for a data block: decodes the count tag and the
+        // following values of the loader. The block is exported in front of
+        // the raw tag at index tags_index.
+        void load_block(tag::AscLoader &loader, std::size_t tags_index,
+                        ErrorMessages &errors);
+
+        void load_tags(tag::StringTags tags, ErrorMessages &errors,
+                       std::size_t line_number) override;
+
+        void for_each_tag(const std::function<void(const tag::StringTag &)>
+                          &fn) const override;
+    };
+}
+#endif //EZDXF_MESH_HPP
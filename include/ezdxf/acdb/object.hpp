@@ -5,19 +5,69 @@
 #define EZDXF_OBJECT_HPP
 
 #include <stdexcept>
+#include <vector>
 #include "ezdxf/type.hpp"
 
+namespace ezdxf::tag {
+    class AscWriter;
+}
+
+namespace ezdxf {
+    template<int N>
+    class ObjectTable;
+}
+
 namespace ezdxf::acdb {
     using ezdxf::Handle;
 
+    class Object;
+
+    // Receives the erase notification of an object stored in an object
+    // table, the index is the insertion index of the object in the table:
+    class EraseListener {
+    public:
+        virtual void object_erased(std::size_t index) = 0;
+
+    protected:
+        ~EraseListener() = default;
+    };
+
+    // Pointer reference to another DXF object as stored by the group codes:
+    // 330-339 soft-pointer handle
+    // 340-349 hard-pointer handle
+    // 350-359 soft-owner handle
+    // 360-369 hard-owner handle
+    //
+    // The handle is the persistent part, the object pointer is set by the
+    // reference resolution stage after loading and is a nullptr as long as
+    // the reference is unresolved or dangling.
+    struct Reference {
+        int code{0};
+        Handle handle{0};
+        Object *object{nullptr};
+
+        Reference(int code_, Handle handle_) : code(code_), handle(handle_) {};
+    };
+
+    inline bool is_pointer_group_code(const int code) {
+        return code >= 330 && code < 370;
+    }
+
     // acdb::Object is the base class for all DXF entities in a DXF Document
     // which have a handle.
     // The handle can only be assigned once!
     class Object {
+        template<int N>
+        friend class ezdxf::ObjectTable;
+
     private:
         unsigned int status_{0};  // status flags
+        uint32_t table_index_{0};  // insertion index in the object table
+        EraseListener *listener_{nullptr};  // set by the object table
         Handle handle_{0};  // 0 represents an unassigned handle
         Handle owner_{0}; // 0 represents no owner
+        Object *owner_object_{nullptr};  // resolved owner handle
+        std::vector<Reference> references_{};
 
     public:
         enum class Status {
@@ -36,10 +86,10 @@ namespace ezdxf::acdb {
         // Returns the DXF type as specified in the DXF file:
         // Object is not a real DXF object, it is the base class for all
         // DXF entities.
-        virtual DXFType dxf_type() { return DXFType::None; }
+        virtual DXFType dxf_type() const { return DXFType::None; }
 
         // Returns the corresponding ObjectARX® type:
-        virtual ARXType arx_type() { return ARXType::AcDbObject; }
+        virtual ARXType arx_type() const { return ARXType::AcDbObject; }
 
         [[nodiscard]] bool is_erased() const {
             return status_ & static_cast<unsigned int>(Status::kErased);
@@ -59,12 +109,42 @@ namespace ezdxf::acdb {
 
         [[nodiscard]] Handle get_owner() const { return owner_; }
 
-        void set_owner(Handle o) { owner_ = o; }
+        void set_owner(Handle o) {
+            owner_ = o;
+            owner_object_ = nullptr;  // requires a new resolving process
+        }
+
+        // Returns the resolved owner object or nullptr if the owner handle
+        // is not resolved yet or the owner does not exist.
+        [[nodiscard]] Object *get_owner_object() const { return owner_object_; }
+
+        void set_owner_object(Object *o) { owner_object_ = o; }
+
+        void add_reference(int code, Handle h) {
+            if (!is_pointer_group_code(code))
+                throw std::invalid_argument("invalid pointer group code");
+            references_.emplace_back(code, h);
+        }
+
+        [[nodiscard]] const std::vector<Reference> &get_references() const {
+            return references_;
+        }
+
+        // Mutable access is required by the resolving process:
+        std::vector<Reference> &get_references() { return references_; }
+
+        // Export the DXF object as DXF tags, the base class has no DXF
+        // representation:
+        virtual void export_dxf(tag::AscWriter &) const {}
 
         virtual void erase() {
             // Set object status to erased, DXF objects will not be destroyed at
             // the lifetime of a DXF document!
+            // Overriding methods have to call Object::erase(), the object
+            // table of a stored object is notified only once.
+            if (is_erased()) return;
             status_ |= static_cast<unsigned int>(Status::kErased);
+            if (listener_) listener_->object_erased(table_index_);
         }
     };
 
@@ -0,0 +1,164 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_POLYLINE_HPP
+#define EZDXF_POLYLINE_HPP
+
+#include <vector>
+#include "ezdxf/type.hpp"
+#include "ezdxf/acdb/entity.hpp"
+#include "ezdxf/tag/loader.hpp"
+
+namespace ezdxf::acdb {
+    class SequenceDecoder;
+
+    // acdb::Polyline stores the POLYLINE entity and its sequence of VERTEX
+    // entities and the final SEQEND entity as a single object. The
+    // vertices are not stored as objects in the object table, the vertex
+    // attributes are stored as contiguous arrays and the handles of the
+    // VERTEX entities in a side array. The VERTEX and SEQEND entities are
+    // rebuilt by the export.
+    //
+    // Vertex tags without a decoded attribute are preserved as extra tags
+    // of the vertex, which are exported after the decoded attributes, except
+    // a layer different from the common vertex layer. Application defined
+    // data (102, "{NAME") ... (102, "}") is preserved separately and
+    // exported after the handle of the VERTEX or SEQEND entity. Pointer
+    // references in these tags are references of the POLYLINE.
+    class Polyline : public Entity {
+        friend class SequenceDecoder;
+
+    public:
+        struct ExtraTag {
+            std::size_t vertex;  // index of the vertex
+            tag::StringTag tag;
+        };
+
+    private:
+        std::vector<Real> x_{};
+        std::vector<Real> y_{};
+        std::vector<Real> z_{};
+        std::vector<Real> start_width_{};
+        std::vector<Real> end_width_{};
+        std::vector<Real> bulge_{};
+        std::vector<int32_t> flags_{};
+        // Polyface mesh face records (71, 72, 73, 74), 4 indices for each
+        // vertex, empty if not present:
+        std::vector<int32_t> face_indices_{};
+        // Handles of the VERTEX entities, 0 for vertices without handle:
+        std::vector<Handle> vertex_handles_{};
+        // Sorted by vertex index:
+        std::vector<ExtraTag> extra_tags_{};
+        // Application defined data, sorted by vertex index:
+        std::vector<ExtraTag> app_data_{};
+        // Layer of the vertices if different from the POLYLINE layer:
+        String vertex_layer_{};
+        Handle seqend_handle_{0};
+        String seqend_layer_{};
+        tag::StringTags seqend_extra_tags_{};
+        tag::StringTags seqend_app_data_{};
+        bool has_seqend_{false};
+        // Loaded VERTEX and SEQEND entities have owner handles (330)
+        // and subclass markers (100), not present in DXF R12:
+        bool owner_tags_{true};
+        bool subclass_markers_{true};
+
+        // Calls fn(tag) for the rebuilt tags of all VERTEX entities and the
+        // SEQEND entity including their structure tags:
+        void for_each_sequence_tag(
+                const std::function<void(const tag::StringTag &)> &fn) const;
+
+    protected:
+        void export_new_object_tags(tag::AscWriter &writer) const override;
+
+        void export_decoded_tags(tag::AscWriter &writer,
+                                 std::size_t index) const override;
+
+    public:
+        Polyline() : Entity(DXFType::Polyline, "POLYLINE") {}
+
+        [[nodiscard]] std::size_t size() const { return x_.size(); }
+
+        [[nodiscard]] const std::vector<Real> &x() const { return x_; }
+
+        [[nodiscard]] const std::vector<Real> &y() const { return y_; }
+
+        [[nodiscard]] const std::vector<Real> &z() const { return z_; }
+
+        [[nodiscard]] const std::vector<Real> &start_width() const {
+            return start_width_;
+        }
+
+        [[nodiscard]] const std::vector<Real> &end_width() const {
+            return end_width_;
+        }
+
+        [[nodiscard]] const std::vector<Real> &bulge() const {
+            return bulge_;
+        }
+
+        [[nodiscard]] const std::vector<int32_t> &vertex_flags() const {
+            return flags_;
+        }
+
+        [[nodiscard]] const std::vector<int32_t> &face_indices() const {
+            return face_indices_;
+        }
+
+        [[nodiscard]] const std::vector<Handle> &vertex_handles() const {
+            return vertex_handles_;
+        }
+
+        [[nodiscard]] const std::vector<ExtraTag> &extra_tags() const {
+            return extra_tags_;
+        }
+
+        [[nodiscard]] const std::vector<ExtraTag> &app_data() const {
+            return app_data_;
+        }
+
+        [[nodiscard]] bool has_seqend() const { return has_seqend_; }
+
+        [[nodiscard]] Handle seqend_handle() const { return seqend_handle_; }
+
+        // Returns the biggest handle of the VERTEX and SEQEND entities, these
+        // handles have to be reserved in the object table:
+        [[nodiscard]] Handle max_sequence_handle() const;
+
+        // Returns the handles of the VERTEX and SEQEND entities without the
+        // 0 handles in sequence order:
+        [[nodiscard]] std::vector<Handle> sequence_handles() const;
+
+        void reserve(std::size_t count);
+
+        // Append a new vertex, the handle of the VERTEX entity has to be
+        // reserved in the object table:
+        void append(Handle handle, Real x, Real y, Real z = 0.0,
+                    int32_t flags = 0);
+
+        // Set the handle of a new SEQEND entity, which is required to
+        // export new vertices:
+        void set_seqend_handle(Handle handle) {
+            seqend_handle_ = handle;
+            has_seqend_ = true;
+        }
+
+        // Loads the VERTEX and SEQEND entities following the POLYLINE
+        // entity, the raw tags of the POLYLINE have to be set. The loader
+        // stops after the SEQEND entity or in front of the first structure
+        // tag which is not a VERTEX entity. Pointer references in the
+        // VERTEX and SEQEND tags are added to the POLYLINE.
+        void load_sequence(tag::AscLoader &loader, ErrorMessages &errors);
+
+        // The tags contain the VERTEX and SEQEND entities following the
+        // POLYLINE tags, including their structure tags (0, VERTEX) and
+        // (0, SEQEND), see for_each_tag(). Pointer references in the
+        // VERTEX and SEQEND tags are not added, see load_sequence():
+        void load_tags(tag::StringTags tags, ErrorMessages &errors,
+                       std::size_t line_number) override;
+
+        void for_each_tag(const std::function<void(const tag::StringTag &)>
+                          &fn) const override;
+    };
+}
+#endif //EZDXF_POLYLINE_HPP
@@ -0,0 +1,43 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_ALLOC_COUNTER_HPP
+#define EZDXF_ALLOC_COUNTER_HPP
+
+#include <cstddef>
+
+// Allocation accounting for tests and benchmarks:
+// The implementation replaces the global operator new and delete and is
+// opt-in, link the ezdxf_alloc_counter target to an executable to use it,
+// the ezdxf library itself never replaces the global operators.
+
+namespace ezdxf::alloc {
+    struct AllocationStats {
+        std::size_t allocations{0};
+        std::size_t deallocations{0};
+        std::size_t bytes{0};  // allocated bytes
+    };
+
+    class AllocationCounter {
+        // Counts the allocations by operator new of all threads during the
+        // lifetime of the counter. Allocations are only counted while at
+        // least one counter exists, otherwise the replaced operator new
+        // costs a single atomic load.
+    private:
+        AllocationStats start_{};
+
+    public:
+        AllocationCounter();
+
+        ~AllocationCounter();
+
+        AllocationCounter(const AllocationCounter &) = delete;
+
+        AllocationCounter &operator=(const AllocationCounter &) = delete;
+
+        // Returns the allocations since construction:
+        [[nodiscard]] AllocationStats stats() const;
+    };
+}
+
+#endif //EZDXF_ALLOC_COUNTER_HPP
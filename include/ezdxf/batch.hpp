@@ -0,0 +1,68 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_BATCH_HPP
+#define EZDXF_BATCH_HPP
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/thread_pool.hpp"
+
+namespace ezdxf {
+    // Size of the per-worker file read buffer, which is reused for all files
+    // loaded by the same worker thread:
+    const std::size_t kBatchReadBufferSize = 1 << 20;
+
+    struct BatchResult {
+        std::string filename{};
+        Document document{};
+        std::string error{};  // empty if the document was loaded
+
+        [[nodiscard]] bool ok() const { return error.empty(); }
+    };
+
+    class BatchLoader {
+        // Loads multiple DXF documents in parallel, one document per task.
+        // The files are started in order of descending file size, so the
+        // biggest files do not delay the end of the batch. The loaded
+        // documents are returned by next() in order of completion.
+        //
+        // Each document is loaded by a single thread, the documents are
+        // independent and can be processed by different threads afterwards.
+    public:
+        explicit BatchLoader(const std::vector<std::string> &filenames,
+                             const LoadOptions &options = {},
+                             ThreadPool &pool = ThreadPool::global());
+
+        // Not started files are skipped, running tasks finish in the
+        // background:
+        ~BatchLoader();
+
+        BatchLoader(const BatchLoader &) = delete;
+
+        BatchLoader &operator=(const BatchLoader &) = delete;
+
+        // Count of files in the batch:
+        [[nodiscard]] std::size_t size() const;
+
+        // Returns the next loaded document or the loading error of the
+        // next failed file and blocks until a file is finished.
+        // Returns an empty optional if all files were returned.
+        // The waiting thread helps processing pending tasks of the pool.
+        std::optional<BatchResult> next();
+
+    private:
+        struct State;
+        ThreadPool &pool_;
+        std::shared_ptr<State> state_;
+    };
+
+    // Loads all files and returns the results in order of completion:
+    std::vector<BatchResult> readfiles(const std::vector<std::string> &,
+                                       const LoadOptions &options = {});
+}
+
+#endif //EZDXF_BATCH_HPP
@@ -0,0 +1,77 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_BINARY_STREAM_HPP
+#define EZDXF_BINARY_STREAM_HPP
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+#include "ezdxf/type.hpp"
+
+namespace ezdxf {
+    // Binary streams for index and snapshot files of the library, the data
+    // is stored in the native byte order. The files are not meant for the
+    // exchange between different platforms, the file headers have to store
+    // a byte order mark to detect invalid files.
+
+    // Limit for the length of stored strings, protects against allocating
+    // huge buffers for corrupt files:
+    const uint32_t kMaxBinaryStringLength = 1 << 24;
+
+    class BinaryWriter {
+    private:
+        std::ostream &stream_;
+
+    public:
+        explicit BinaryWriter(std::ostream &stream) : stream_(stream) {}
+
+        template<typename T>
+        void write(const T &value) {
+            static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+            stream_.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        void write(const String &s) {
+            write(static_cast<uint32_t>(s.size()));
+            stream_.write(s.data(), static_cast<std::streamsize>(s.size()));
+        }
+
+        [[nodiscard]] bool ok() const { return stream_.good(); }
+    };
+
+    class BinaryReader {
+        // The reader stops reading at the first error, all following read()
+        // calls return false.
+    private:
+        std::istream &stream_;
+        bool ok_{true};
+
+    public:
+        explicit BinaryReader(std::istream &stream) : stream_(stream) {}
+
+        template<typename T>
+        bool read(T &value) {
+            static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+            if (ok_) {
+                stream_.read(reinterpret_cast<char *>(&value), sizeof(T));
+                ok_ = stream_.gcount() == sizeof(T);
+            }
+            return ok_;
+        }
+
+        bool read(String &s) {
+            uint32_t size = 0;
+            if (!read(size)) return false;
+            if (size > kMaxBinaryStringLength) return ok_ = false;
+            s.resize(size);
+            stream_.read(s.data(), size);
+            return ok_ = stream_.gcount() == size;
+        }
+
+        [[nodiscard]] bool ok() const { return ok_; }
+    };
+}
+
+#endif //EZDXF_BINARY_STREAM_HPP
@@ -0,0 +1,61 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_BUILDER_HPP
+#define EZDXF_BUILDER_HPP
+
+#include <memory>
+#include <vector>
+#include "ezdxf/type.hpp"
+#include "ezdxf/acdb/object.hpp"
+
+namespace ezdxf {
+    using ezdxf::acdb::Object;
+
+    class Document;
+
+    // Count of handles reserved at once by an EntityBuilder:
+    const Handle kHandleBlockSize = 1024;
+
+    class EntityBuilder {
+        // The EntityBuilder creates new DXF objects for a document in a
+        // separated thread: The builder owns the new objects until they are
+        // merged into the document by Document::merge() and assigns handles
+        // from handle blocks reserved atomically from the object table of
+        // the document. Each thread has to use its own builder, a builder is
+        // not thread safe.
+        //
+        // The first handle block is reserved by the constructor, builders
+        // created in a fixed order by a single thread get the same handles
+        // in each run, as long as no builder needs a second handle block.
+    public:
+        explicit EntityBuilder(Document &doc,
+                               Handle block_size = kHandleBlockSize);
+
+        // Takes ownership of a new DXF object and assigns a new handle if
+        // the object has no handle. The object is stored in the document
+        // by the next Document::merge() call.
+        // Returns a reference to the object. Objects with an assigned handle,
+        // which is already used in the document at merging, are rejected and
+        // destroyed by Document::merge(), the returned reference of a
+        // rejected object is invalid after merging!
+        Object *add(std::unique_ptr<Object> object);
+
+        // Returns the count of objects not merged yet:
+        [[nodiscard]] std::size_t size() const { return objects_.size(); }
+
+        [[nodiscard]] bool empty() const { return objects_.empty(); }
+
+    private:
+        friend class Document;
+
+        Document *doc_;
+        Handle block_size_;
+        Handle next_handle_{0};
+        Handle end_handle_{0};  // end of the reserved handle block
+        // New objects in order of creation:
+        std::vector<std::unique_ptr<Object>> objects_{};
+    };
+}
+
+#endif //EZDXF_BUILDER_HPP
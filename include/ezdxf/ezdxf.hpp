@@ -4,22 +4,342 @@
 #ifndef EZDXF_EZDXF_HPP
 #define EZDXF_EZDXF_HPP
 
+#include <istream>
+#include <memory>
+#include <ostream>
 #include <string>
+#include <unordered_set>
 #include <utility>
+#include <vector>
+#include "ezdxf/type.hpp"
+#include "ezdxf/builder.hpp"
+#include "ezdxf/geometry_store.hpp"
+#include "ezdxf/lazy_index.hpp"
+#include "ezdxf/load_stats.hpp"
+#include "ezdxf/progress.hpp"
 #include "ezdxf/tag/loader.hpp"
+#include "ezdxf/object_table.hpp"
+#include "ezdxf/owner_index.hpp"
+#include "ezdxf/type_index.hpp"
 
 namespace ezdxf {
+    struct Section {
+        // A DXF section in order of the DXF file. The HEADER, CLASSES and
+        // all unknown sections are stored as raw tags, the TABLES, BLOCKS,
+        // ENTITIES and OBJECTS sections are stored as references to the
+        // objects in file order, the objects are owned by the object table.
+        String name;
+        tag::StringTags tags{};
+        std::vector<Object *> objects{};
+
+        explicit Section(String name_) : name(std::move(name_)) {};
+    };
+
+    struct LoadOptions {
+        // Selective loading: Graphical entities (all types of the DXFType
+        // enum) of other types or on other layers are skipped, all other
+        // DXF objects are always loaded. Empty filters accept all entities,
+        // layer names are case insensitive.
+        std::vector<DXFType> types{};
+        std::vector<String> layers{};
+        // The progress callback is called after each progress_interval
+        // bytes and at the end of loading:
+        ProgressCallback progress{};
+        std::size_t progress_interval{kDefaultProgressInterval};
+        // Loading stops as soon as possible if the token is cancelled,
+        // load() returns false and logs a kLoadingCancelled error:
+        CancellationToken cancellation{};
+        // Columnar storage mode: the geometry of LINE, POINT, CIRCLE and
+        // ARC entities is stored in the GeometryStore of the document and
+        // the entities are loaded as acdb::ColumnarEntity, see
+        // Document::get_geometry_store():
+        bool columnar_geometry{false};
+    };
+
+    class EntityFilter;
+
+    class LoadMonitor;
+
+    enum class ExportOrder {
+        kFileOrder,  // order of loading and insertion
+        // ENTITIES and OBJECTS section sorted by handle, INSERT entities
+        // are sorted together with their ATTRIB and SEQEND entities and the
+        // root DICTIONARY stays the first object of the OBJECTS section:
+        kHandleOrder,
+    };
+
     class Document {
         // Main DXF document
     public:  // functions
         Document() = default;
-        bool load(const ezdxf::tag::Loader&);
+
+        bool load(tag::AscLoader &, const LoadOptions &options = {});
+
+        // Lazy loading mode: Prescan the DXF data and store only the
+        // location of the DXF objects in the input stream, the objects are
+        // loaded on first access by the non-const get() function.
+        // The input stream has to be seekable and has to be opened in binary
+        // mode, the stream is owned by the document until all objects are
+        // loaded.
+        //
+        // Only get() is available for not loaded objects, the query(),
+        // children() and export_dxf() functions and the pointer references
+        // of the loaded objects are valid after loading all objects by
+        // materialize_all(). Functions which change the document load all
+        // objects automatically.
+        bool load_lazy(std::unique_ptr<std::istream> stream);
+
+        // Lazy loading mode by the offset index of a previous prescan,
+        // written by save_lazy_index(), the prescan is skipped. The index
+        // has to match the DXF data, which is not checked!
+        // Returns false for invalid index data, the document is unchanged
+        // in this case and the input stream is closed.
+        bool load_lazy(std::unique_ptr<std::istream> stream,
+                       std::istream &lazy_index);
+
+        // Writes the result of the prescan: section structure, loading
+        // errors and offset index. Returns false if the document is not in
+        // lazy loading mode or for write errors.
+        bool save_lazy_index(std::ostream &stream) const;
+
+        // Writes a binary snapshot of the document, which can be loaded
+        // without parsing DXF tags, see load_snapshot() and the snapshot
+        // format in ezdxf/snapshot.hpp. Erased objects are not stored.
+        // Returns false for write errors.
+        bool save_snapshot(std::ostream &stream) const;
+
+        // Load a binary snapshot written by save_snapshot(), the snapshot is
+        // validated by the header and the checksum of the payload. Returns
+        // false for invalid snapshots, the document is unchanged in this
+        // case. Export the loaded document by export_dxf() to convert the
+        // snapshot back to DXF.
+        bool load_snapshot(std::istream &stream);
+
+        // Returns true if the document has not loaded objects:
+        [[nodiscard]] bool is_lazy() const { return lazy_ != nullptr; }
+
+        // Load all not loaded objects and build all indices, ends the lazy
+        // loading mode. Returns the count of loaded objects.
+        std::size_t materialize_all();
+
+        // Returns a reference to the DXF object or nullptr, loads not loaded
+        // objects of the lazy loading mode.
+        // Does not transfer ownership!
+        [[nodiscard]] Object *get(Handle handle) {
+            return objects_.get(handle);
+        }
+
+        // Returns a reference to the DXF object or nullptr, does not load
+        // objects of the lazy loading mode.
+        // Does not transfer ownership!
+        [[nodiscard]] Object *get(Handle handle) const {
+            return objects_.get(handle);
+        }
+
+        // Transfer ownership of a new DXF object to the document, assigns a
+        // new handle if the object has no handle.
+        // Returns a reference to the stored object.
+        Object *add(std::unique_ptr<Object> object);
+
+        // Reserve a block of count unused handles, returns the first handle
+        // of the block. This function is thread safe, see EntityBuilder.
+        Handle reserve_handles(Handle count) {
+            check_mutable();
+            return objects_.reserve_handles(count);
+        }
+
+        // Transfer ownership of all DXF objects of the builders to the
+        // document in one batch step. The objects are added in builder order
+        // and in order of creation, which is independent from the thread
+        // scheduling of the builders. References between the merged objects
+        // are resolved after storing all objects and the owner and type
+        // indices are rebuilt once. The builders are empty afterwards.
+        // Objects with handles in use, including the handles of VERTEX and
+        // SEQEND entities and skipped entities, are logged as
+        // kDuplicateHandle and destroyed, see EntityBuilder::add().
+        void merge(std::vector<EntityBuilder> &builders);
+
+        // Set object status to erased, the object will not be destroyed
+        // until the next purge() call!
+        void erase(Object *object);
+
+        // Destroys all erased objects and removes them from all sections and
+        // indices, e.g. before export. All references to erased objects are
+        // invalid after purging!
+        // Returns the count of destroyed objects.
+        std::size_t purge();
+
+        // Makes the document immutable, all functions which change the
+        // document (load, add, erase, purge) throw std::logic_error
+        // afterwards. Loads all objects of the lazy loading mode.
+        // A frozen document is a read-only snapshot, which can be processed
+        // by multiple threads without locks: get(), query(), children(), the
+        // iteration of the object table, export_dxf() and all const member
+        // functions of the DXF objects are safe for concurrent readers.
+        // Changing DXF objects of a frozen document is not allowed and not
+        // detected!
+        void freeze();
+
+        [[nodiscard]] bool is_frozen() const { return frozen_; }
+
+        // Export the document as ASCII DXF in a stable order, independent
+        // from the hash table layout. The TABLES and BLOCKS sections are
+        // always exported in file order, because their structure depends on
+        // the object order. Erased objects are not exported. The handle
+        // order is cached until the object table changes.
+        void export_dxf(std::ostream &stream,
+                        ExportOrder order = ExportOrder::kFileOrder) const;
+
+        // Returns all DXF entities of the given type in order of insertion,
+        // erased entities are not included.
+        [[nodiscard]] const std::vector<Object *> &query(DXFType type) const {
+            return types_.get(type);
+        }
+
+        // Returns the children of the given owner handle.
+        [[nodiscard]] Children children(Handle owner) const {
+            return owners_.children(owner);
+        }
+
+        // Returns the handle of the modelspace BLOCK_RECORD or 0 if not
+        // available (DXF R12).
+        [[nodiscard]] Handle get_modelspace_handle() const {
+            return modelspace_;
+        }
+
+        [[nodiscard]] const ObjectTable<> &get_object_table() const {
+            return objects_;
+        }
+
+        [[nodiscard]] const std::vector<Section> &get_sections() const {
+            return sections_;
+        }
+
+        // Returns the statistics of the last load() call:
+        [[nodiscard]] const LoadStats &get_load_stats() const {
+            return load_stats_;
+        }
+
+        // Returns the geometry store of the columnar storage mode or nullptr
+        // if no entities were loaded in columnar storage mode, see
+        // LoadOptions::columnar_geometry. The mutable store allows to
+        // transform the geometry in place.
+        [[nodiscard]] const GeometryStore *get_geometry_store() const {
+            return geometry_.get();
+        }
+
+        [[nodiscard]] GeometryStore *get_geometry_store() {
+            return geometry_.get();
+        }
+
+        // Returns the sorted handles of the entities skipped by selective
+        // loading, these handles are never reused for new objects and
+        // references to these handles are not logged as dangling.
+        [[nodiscard]] const std::vector<Handle> &get_skipped_handles() const {
+            return skipped_;
+        }
+
+        // Returns loading errors and audit findings:
+        [[nodiscard]] const ErrorMessages &get_errors() const {
+            return errors_;
+        }
 
     public:  // attributes
         std::string filename;
+
+    private:
+        ObjectTable<> objects_{};
+        OwnerIndex owners_{};
+        TypeIndex types_{};
+        std::vector<Section> sections_{};
+        ErrorMessages errors_{};
+        std::vector<Handle> skipped_{};  // sorted
+        // Handles of the loaded VERTEX and SEQEND entities, which are not
+        // stored in the object table:
+        std::unordered_set<Handle> sequence_handles_{};
+        LoadStats load_stats_{};
+        Handle modelspace_{0};
+        bool frozen_{false};
+        // Heap allocated, the columnar entities refer to the store, which
+        // has to be valid for moved documents:
+        std::unique_ptr<GeometryStore> geometry_{};
+        // Shared with the materializer of the object table, which has
+        // to be valid for moved documents:
+        std::shared_ptr<LazyLoader> lazy_{};
+
+        struct PendingObject {
+            // Loaded object without handle, the handle will be assigned
+            // after loading, when the biggest used handle is known.
+            std::size_t section;
+            std::size_t position;
+            std::unique_ptr<Object> object;
+        };
+        std::vector<PendingObject> pending_{};
+
+        // Objects of the ENTITIES and OBJECTS sections sorted by handle for
+        // the export in handle order, one array for each section, cached
+        // until the object table changes:
+        mutable std::vector<std::vector<Object *>> handle_order_{};
+        mutable uint64_t handle_order_revision_{UINT64_MAX};
+
+        void check_mutable() const;
+
+        void prepare_change();
+
+        void prescan_section(tag::BasicLoader &, std::vector<LazyEntry> &);
+
+        void prescan_objects(tag::BasicLoader &, std::vector<LazyEntry> &);
+
+        void load_section(tag::AscLoader &, const EntityFilter &,
+                          LoadMonitor &);
+
+        void load_objects(tag::AscLoader &, Section &, const EntityFilter &,
+                          LoadMonitor &);
+
+        std::unique_ptr<Object> load_filtered_object(tag::AscLoader &,
+                                                     const EntityFilter &);
+
+        [[nodiscard]] Handle find_duplicate_handle(const Object &) const;
+
+        void skip_object(tag::AscLoader &);
+
+        void skip_sequence(tag::AscLoader &, DXFType);
+
+        void assign_missing_handles();
+
+        void build_indices(LoadStats *stats = nullptr);
+
+        void unlink_purged_objects(const std::vector<Handle> &purged);
+
+        void update_handle_order() const;
+
+        [[nodiscard]] const Section *find_section(const String &name) const;
+
+        Section &get_section(const String &name);
+
+        void log_structure_error(const String &message,
+                                 std::size_t line_number);
     };
 
-    Document readfile(const std::string&);
+    Document readfile(const std::string &, const LoadOptions &options = {});
+
+    // Open a DXF file in lazy loading mode, see Document::load_lazy():
+    Document readfile_lazy(const std::string &);
+
+    // Open a DXF file in lazy loading mode and reuse the offset index of
+    // the sidecar index file <filename>.ezidx to skip the prescan. The
+    // sidecar index is valid for the same file size, modification time and
+    // content hash of sampled blocks, else the index is rebuilt and the
+    // sidecar index file is replaced.
+    Document readfile_indexed(const std::string &);
+
+    std::string sidecar_index_filename(const std::string &);
+
+    // Load a binary snapshot file, see Document::load_snapshot(), returns
+    // an empty document for invalid snapshot files:
+    Document readsnapshot(const std::string &);
+
+    bool writesnapshot(const Document &, const std::string &);
 }
 
 #endif //EZDXF_EZDXF_HPP
@@ -0,0 +1,145 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_GEOMETRY_STORE_HPP
+#define EZDXF_GEOMETRY_STORE_HPP
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "ezdxf/type.hpp"
+#include "ezdxf/span.hpp"
+#include "ezdxf/math/vec3.hpp"
+
+namespace ezdxf::acdb {
+    class Object;
+
+    class Entity;
+
+    class ColumnarEntity;
+}
+
+namespace ezdxf {
+    // Maximum count of geometry tag groups of a columnar entity type:
+    const std::size_t kMaxGeometryGroups = 4;
+
+    class GeometryColumns {
+        // Geometry of all columnar entities of a DXF type as structure of
+        // arrays, one column for each group code of the geometry tags, e.g.
+        // the LINE columns are start.x (10), start.y (20), start.z (30),
+        // end.x (11), end.y (21) and end.z (31). Each entity is a row of
+        // the columns, the rows are stored in order of loading.
+    private:
+        DXFType type_;
+        // Geometry tags as groups of consecutive group codes, e.g. a vertex
+        // (10, 20, 30) or the radius (40):
+        std::vector<std::vector<int>> groups_;
+        std::vector<int> codes_;  // group codes of the columns
+        std::vector<std::vector<Real>> columns_;
+        std::vector<acdb::ColumnarEntity *> entities_;  // entity of each row
+
+        [[nodiscard]] std::size_t column_index(int code) const;
+
+    public:
+        GeometryColumns(DXFType type, std::vector<std::vector<int>> groups);
+
+        [[nodiscard]] DXFType type() const { return type_; }
+
+        [[nodiscard]] std::size_t size() const { return entities_.size(); }
+
+        [[nodiscard]] const std::vector<std::vector<int>> &groups() const {
+            return groups_;
+        }
+
+        [[nodiscard]] const std::vector<int> &codes() const { return codes_; }
+
+        // Returns the column of the given group code, throws
+        // std::invalid_argument for group codes without a column:
+        [[nodiscard]] Span<Real> column(int code) const;
+
+        // Mutable access to the column values for transformation kernels,
+        // the column has size() values:
+        [[nodiscard]] Real *column_data(int code);
+
+        // Returns the entity of the given row, does not transfer ownership!
+        [[nodiscard]] acdb::ColumnarEntity *entity(std::size_t row) const {
+            return entities_[row];
+        }
+
+        // Moves a loaded entity into a new ColumnarEntity and appends its
+        // geometry as a new row. Returns nullptr if the geometry tags do not
+        // match the groups, e.g. a missing z-axis of a DXF R12 entity, the
+        // entity is unchanged in this case.
+        std::unique_ptr<acdb::ColumnarEntity> adopt(acdb::Entity &entity);
+
+        // Removes the rows of erased entities and renumbers the rows of the
+        // remaining entities, the erased entities have to be alive:
+        void remove_erased();
+    };
+
+    class GeometryStore {
+        // Columnar storage of the geometry of LINE, POINT, CIRCLE and ARC
+        // entities, which is owned by the document, see
+        // LoadOptions::columnar_geometry.
+        //
+        // The kernels process all rows including the rows of erased
+        // entities, which are removed by Document::purge(). The CIRCLE and
+        // ARC centers are OCS coordinates and are ignored by the kernels.
+    private:
+        GeometryColumns points_;
+        GeometryColumns lines_;
+        GeometryColumns circles_;
+        GeometryColumns arcs_;
+
+    public:
+        GeometryStore();
+
+        // The columnar entities refer to the columns of the store:
+        GeometryStore(const GeometryStore &) = delete;
+
+        GeometryStore &operator=(const GeometryStore &) = delete;
+
+        [[nodiscard]] const GeometryColumns &points() const { return points_; }
+
+        [[nodiscard]] GeometryColumns &points() { return points_; }
+
+        [[nodiscard]] const GeometryColumns &lines() const { return lines_; }
+
+        [[nodiscard]] GeometryColumns &lines() { return lines_; }
+
+        [[nodiscard]] const GeometryColumns &circles() const {
+            return circles_;
+        }
+
+        [[nodiscard]] GeometryColumns &circles() { return circles_; }
+
+        [[nodiscard]] const GeometryColumns &arcs() const { return arcs_; }
+
+        [[nodiscard]] GeometryColumns &arcs() { return arcs_; }
+
+        // Returns the columns of the DXF type or nullptr for DXF types
+        // without columnar storage:
+        [[nodiscard]] GeometryColumns *columns(DXFType type);
+
+        // Returns the count of rows of all types:
+        [[nodiscard]] std::size_t size() const;
+
+        // Returns a ColumnarEntity for loaded LINE, POINT, CIRCLE and ARC
+        // entities with a matching geometry, else the unchanged object.
+        std::unique_ptr<acdb::Object>
+        adopt(std::unique_ptr<acdb::Object> object);
+
+        void remove_erased();
+
+        // Returns the WCS bounding box (min, max) of all POINT and LINE
+        // entities or nothing if the store has no POINT and LINE entities:
+        [[nodiscard]] std::optional<std::pair<math::Vec3, math::Vec3>>
+        bounding_box() const;
+
+        // Translate all POINT and LINE entities:
+        void translate(Real dx, Real dy, Real dz);
+    };
+}
+
+#endif //EZDXF_GEOMETRY_STORE_HPP
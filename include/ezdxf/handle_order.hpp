@@ -0,0 +1,21 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_HANDLE_ORDER_HPP
+#define EZDXF_HANDLE_ORDER_HPP
+
+#include <vector>
+#include "ezdxf/type.hpp"
+#include "ezdxf/acdb/object.hpp"
+
+namespace ezdxf {
+    using ezdxf::acdb::Object;
+
+    // Sort objects by handle in ascending order. This is a stable LSD radix
+    // sort over the 64-bit handles, which is much faster than a comparison
+    // sort for big documents. Byte positions which are equal for all handles
+    // (the high bytes in most cases) are skipped.
+    void sort_by_handle(std::vector<Object *> &objects);
+}
+
+#endif //EZDXF_HANDLE_ORDER_HPP
@@ -0,0 +1,107 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_LAZY_INDEX_HPP
+#define EZDXF_LAZY_INDEX_HPP
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ezdxf/type.hpp"
+#include "ezdxf/binary_stream.hpp"
+#include "ezdxf/acdb/object.hpp"
+
+namespace ezdxf {
+    using ezdxf::acdb::Object;
+
+    // Identification of stored lazy loading indices, see
+    // Document::save_lazy_index():
+    const char *const kLazyIndexMagic = "EZDXF-LAZY-INDEX";
+    const uint32_t kLazyIndexVersion = 2;
+    const uint32_t kByteOrderMark = 0x01020304;
+
+    struct LazyEntry {
+        // Location of a not loaded DXF object in the DXF file:
+        Handle handle;
+        DXFType type;  // DXFType::None for all other DXF objects
+        uint32_t section;  // index of the section in the document
+        uint32_t position;  // index of the object in the section
+        uint64_t offset;  // byte offset of the structure tag (0, name)
+        uint64_t length;  // count of bytes until the next structure tag
+    };
+
+    class LazyIndex {
+        // Offset index of the DXF objects in a DXF file. The entries are
+        // stored in file order, the lookup by handle is a binary search
+        // in an array of entry indices sorted by handle.
+    private:
+        std::vector<LazyEntry> entries_{};
+        std::vector<uint32_t> by_handle_{};
+
+    public:
+        LazyIndex() = default;
+
+        // Entries have to be added in file order:
+        void add(const LazyEntry &entry) { entries_.push_back(entry); }
+
+        // Build the handle lookup after adding all entries. Returns the
+        // indices of the entries with duplicate handles in file order,
+        // the first entry of a handle in file order is the valid entry.
+        std::vector<uint32_t> build();
+
+        // Returns the valid entry of the given handle or nullptr.
+        [[nodiscard]] const LazyEntry *find(Handle handle) const;
+
+        [[nodiscard]] const std::vector<LazyEntry> &entries() const {
+            return entries_;
+        }
+
+        [[nodiscard]] std::size_t size() const { return entries_.size(); }
+
+        [[nodiscard]] std::size_t count(DXFType type) const;
+
+        // Returns the biggest handle of all entries or 0:
+        [[nodiscard]] Handle max_handle() const {
+            return by_handle_.empty() ? 0 : entries_[by_handle_.back()].handle;
+        }
+
+        // Write the entries and the handle lookup, a restored index does not
+        // need a rebuild:
+        void write(BinaryWriter &writer) const;
+
+        // Restore an index written by write(), returns false for invalid
+        // data and the index is empty.
+        bool read(BinaryReader &reader);
+    };
+
+    class LazyLoader {
+        // Loads DXF objects on demand from a seekable input stream, the
+        // object location is stored in the LazyIndex. The LazyLoader is not
+        // thread safe!
+    private:
+        std::unique_ptr<std::istream> stream_;
+        LazyIndex index_;
+        std::string buffer_{};
+        ErrorMessages errors_{};
+
+    public:
+        LazyLoader(std::unique_ptr<std::istream> stream, LazyIndex index) :
+                stream_(std::move(stream)), index_(std::move(index)) {}
+
+        // Loads the DXF object of the given handle from the input stream,
+        // returns nullptr for unknown handles and read errors.
+        // Each call loads a new instance of the DXF object!
+        std::unique_ptr<Object> load(Handle handle);
+
+        [[nodiscard]] const LazyIndex &index() const { return index_; }
+
+        // Returns the loading errors of all loaded objects:
+        [[nodiscard]] const ErrorMessages &get_errors() const {
+            return errors_;
+        }
+    };
+}
+
+#endif //EZDXF_LAZY_INDEX_HPP
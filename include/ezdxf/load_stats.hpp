@@ -0,0 +1,63 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_LOAD_STATS_HPP
+#define EZDXF_LOAD_STATS_HPP
+
+#include <array>
+#include <map>
+#include "ezdxf/type.hpp"
+#include "ezdxf/tag/tag.hpp"
+
+namespace ezdxf {
+    enum class LoadPhase {
+        // Reading, tokenizing, decoding typed tags and constructing DXF
+        // objects is a single streaming pass and is timed as one phase:
+        kParse,
+        kAssignHandles,
+        kResolveReferences,
+        kBuildIndices,  // owner index, type index and layouts
+    };
+
+    // Count of LoadPhase enums, has to be updated if new phases are added:
+    constexpr std::size_t kLoadPhaseCount =
+            static_cast<std::size_t>(LoadPhase::kBuildIndices) + 1;
+
+    struct LoadStats {
+        // Statistics of the last Document::load() call. Collecting requires
+        // only counters and a clock reading per phase.
+        // The bytes and tags are counted by the loader and include data
+        // consumed by the loader in front of the load() call.
+        std::size_t bytes{0};  // bytes read from the input stream
+        std::size_t objects{0};  // loaded DXF objects including entities
+        std::array<std::size_t, tag::kTagTypeCount> tags{};
+        std::array<std::size_t, kDXFTypeCount> entities{};
+        std::map<ErrorCode, std::size_t> errors{};
+        std::array<double, kLoadPhaseCount> seconds{};  // wall time
+
+        [[nodiscard]] std::size_t count(tag::TagType type) const {
+            return tags[static_cast<std::size_t>(type)];
+        }
+
+        [[nodiscard]] std::size_t count(DXFType type) const {
+            return entities[static_cast<std::size_t>(type)];
+        }
+
+        [[nodiscard]] std::size_t count(ErrorCode code) const {
+            auto it = errors.find(code);
+            return it == errors.end() ? 0 : it->second;
+        }
+
+        [[nodiscard]] double phase_seconds(LoadPhase phase) const {
+            return seconds[static_cast<std::size_t>(phase)];
+        }
+
+        [[nodiscard]] double total_seconds() const {
+            double total = 0.0;
+            for (auto const value : seconds) total += value;
+            return total;
+        }
+    };
+}
+
+#endif //EZDXF_LOAD_STATS_HPP
@@ -4,11 +4,16 @@
 #ifndef EZDXF_OBJECT_TABLE_HPP
 #define EZDXF_OBJECT_TABLE_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 #include <memory>
 #include "ezdxf/type.hpp"
 #include "ezdxf/acdb/object.hpp"
+#include "ezdxf/handle_order.hpp"
 
 namespace ezdxf {
     using ezdxf::Handle;
@@ -25,7 +30,8 @@ namespace ezdxf {
         // Goal: A compact and fast enough DXF object lookup by handle.
         // Relationship between handle and object is fixed and does not
         // change over the lifetime of a document and DXF objects will also not
-        // destroyed, therefore deleting table entries is not required.
+        // destroyed, except by an explicit purge() call, which destroys all
+        // erased objects.
         // Table size is fixed and will not grow over runtime.
 
     private:
@@ -35,22 +41,87 @@ namespace ezdxf {
         };
         using Bucket = std::vector<TableEntry>;
 
-        constexpr int count = 1 << N;  // fixed count of buckets as power of 2
-        constexpr uint64_t hash_mask = count - 1;
+        struct ErasedBitmap final : acdb::EraseListener {
+            // Bitmap of erased objects, bit i represents objects_[i]. The
+            // stored objects notify the bitmap by Object::erase(), the
+            // bitmap is heap allocated to keep its address stable for
+            // moved tables.
+            std::vector<uint64_t> words{};
+            std::size_t count{0};  // count of set bits
+            uint64_t changes{0};  // count of erased objects ever
+
+            void object_erased(std::size_t const index) override {
+                words[index >> 6] |= uint64_t(1) << (index & 63);
+                ++count;
+                ++changes;
+            }
+
+            [[nodiscard]] bool is_set(std::size_t const index) const {
+                return words[index >> 6] & (uint64_t(1) << (index & 63));
+            }
+        };
+
+        struct HandleCounter {
+            // Atomic handle counter, which is movable to keep the object
+            // table movable. Moving is not thread safe!
+            std::atomic<Handle> value{0};
+
+            HandleCounter() = default;
+
+            HandleCounter(HandleCounter &&other) noexcept:
+                    value(other.value.load()) {}
+
+            HandleCounter &operator=(HandleCounter &&other) noexcept {
+                value = other.value.load();
+                return *this;
+            }
+        };
+
+        static constexpr int count = 1 << N;  // fixed count of buckets as power of 2
+        static constexpr uint64_t hash_mask = count - 1;
         std::vector<Bucket> buckets{count};
-        Handle max_handle_{0}; // biggest stored handle
-        std::size_t size_{0};  // count of DXF objects stored
+        // All stored objects in order of insertion, for fast linear iteration
+        // without visiting empty buckets:
+        std::vector<Object *> objects_{};
+        std::unique_ptr<ErasedBitmap> erased_ =
+                std::make_unique<ErasedBitmap>();
+        // Biggest stored or reserved handle:
+        HandleCounter max_handle_{};
+        // Revision counter, changes if objects are stored or purged, see
+        // revision():
+        uint64_t revision_{0};
+        // Loads objects on demand, see set_materializer():
+        std::function<std::unique_ptr<Object>(Handle)> materializer_{};
+        // Cached handle order of the alive objects:
+        mutable std::vector<Object *> handle_order_{};
+        mutable uint64_t handle_order_revision_{UINT64_MAX};
+
+        [[nodiscard]] Bucket &get_bucket(Handle const handle) {
+            return buckets[handle & hash_mask];
+        };
 
-        [[nodiscard]] Bucket get_bucket(Handle const handle) const {
+        [[nodiscard]] Bucket const &get_bucket(Handle const handle) const {
             return buckets[handle & hash_mask];
         };
 
+        static int count_trailing_zeros(uint64_t const value) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(value);
+#else
+            int count = 0;
+            for (uint64_t v = value; !(v & 1); v >>= 1) ++count;
+            return count;
+#endif
+        }
+
     public:
-        [[nodiscard]] std::size_t size() const { return size_; }
+        using const_iterator = std::vector<Object *>::const_iterator;
+
+        [[nodiscard]] std::size_t size() const { return objects_.size(); }
 
         // "get()" is the most important function here:
         Object *
-        get(Handle const handle, Object const *const default_ = nullptr) const {
+        get(Handle const handle, Object *const default_ = nullptr) const {
             // Returns a reference to a DXF object.
             // Does not transfer ownership!
             for (TableEntry const &entry : get_bucket(handle)) {
@@ -60,11 +131,52 @@ namespace ezdxf {
             return default_;
         }
 
+        Object *get(Handle const handle) {
+            // Returns a reference to a DXF object and loads not existing
+            // objects by the materializer, if a materializer is set.
+            // The const get() never calls the materializer.
+            // Does not transfer ownership!
+            if (Object *object = std::as_const(*this).get(handle)) return object;
+            if (!materializer_ || handle == 0) return nullptr;
+            auto object = materializer_(handle);
+            return object ? store(std::move(object)) : nullptr;
+        }
+
+        void set_materializer(
+                std::function<std::unique_ptr<Object>(Handle)> materializer) {
+            // The materializer loads not existing objects by the non-const
+            // get() function, the materializer returns nullptr for unknown
+            // handles. Set nullptr to remove the materializer.
+            materializer_ = std::move(materializer);
+        }
+
         Handle aquire_free_handle() {
             // Return next unused handle. The object table does not return the
             // same handle again, but does not prevent adding objects using
             // that handles.
-            return ++max_handle_;
+            return reserve_handles(1);
+        }
+
+        Handle reserve_handles(Handle count) {
+            // Reserve a block of count unused handles and returns the first
+            // handle of the block, the block is [first, first + count).
+            // This is the only thread safe function which changes the object
+            // table, multiple threads can reserve handle blocks at the same
+            // time, e.g. the EntityBuilder.
+            return max_handle_.value.fetch_add(count) + 1;
+        }
+
+        [[nodiscard]] Handle max_handle() const {
+            // Returns the biggest stored or reserved handle.
+            return max_handle_.value.load();
+        }
+
+        void reserve_handles_until(Handle const handle) {
+            // Mark all handles until the given handle as used, e.g. for
+            // objects which are not stored yet.
+            Handle max_handle = max_handle_.value.load();
+            while (handle > max_handle && !max_handle_.value
+                    .compare_exchange_weak(max_handle, handle)) {}
         }
 
         [[nodiscard]] inline bool has(Handle const handle) const {
@@ -80,20 +192,144 @@ namespace ezdxf {
             return has(object->get_handle());
         }
 
-        void store(std::unique_ptr<Object> object) {
+        Object *store(std::unique_ptr<Object> object) {
             // Transfer ownership of the DXF object to the object table.
+            // Returns a reference to the stored object.
             Handle handle = object->get_handle();
             // The "0" handle is an invalid handle per definition
             if (handle == 0)
                 throw (std::invalid_argument("object handle 0 is invalid"));
             if (!has(handle)) { // Transfer ownership:
-                get_bucket(handle).emplace_pack(handle, object);
-                ++size_;
-                if (handle > max_handle_) max_handle_ = handle;
+                Object *ptr = object.get();
+                get_bucket(handle).push_back(
+                        TableEntry{handle, std::move(object)});
+                ptr->table_index_ = static_cast<uint32_t>(objects_.size());
+                ptr->listener_ = erased_.get();
+                objects_.push_back(ptr);
+                if ((objects_.size() & 63) == 1) erased_->words.push_back(0);
+                if (ptr->is_erased()) erased_->object_erased(ptr->table_index_);
+                reserve_handles_until(handle);
+                ++revision_;
+                return ptr;
             } else
                 throw (std::invalid_argument(
                         "object with same handle already exist"));
         }
-    }
+
+        bool erase(Handle const handle) {
+            // Set object status to erased, same as Object::erase(), the
+            // object is not destroyed until the next purge() call.
+            // Returns false if the handle does not exist.
+            Object *object = get(handle, nullptr);
+            if (!object) return false;
+            object->erase();
+            return true;
+        }
+
+        [[nodiscard]] std::size_t alive_count() const {
+            return objects_.size() - erased_->count;
+        }
+
+        template<typename Function>
+        void for_each_alive(Function fn) const {
+            // Call fn(Object *) for all not erased objects in order of
+            // insertion. The erased bitmap is processed 64 objects at once,
+            // dead objects are skipped without touching the objects
+            // themselves.
+            const std::size_t size = objects_.size();
+            auto const &words = erased_->words;
+            for (std::size_t word_index = 0;
+                 word_index < words.size(); ++word_index) {
+                uint64_t alive = ~words[word_index];
+                const std::size_t base = word_index << 6;
+                if (size - base < 64)  // mask unused bits of the last word
+                    alive &= (uint64_t(1) << (size - base)) - 1;
+                while (alive) {
+                    fn(objects_[base + count_trailing_zeros(alive)]);
+                    alive &= alive - 1;  // clear lowest set bit
+                }
+            }
+        }
+
+        template<typename Function>
+        void for_each_erased(Function fn) const {
+            // Call fn(Object *) for all erased objects in order of insertion.
+            auto const &words = erased_->words;
+            for (std::size_t word_index = 0;
+                 word_index < words.size(); ++word_index) {
+                uint64_t erased = words[word_index];
+                const std::size_t base = word_index << 6;
+                while (erased) {
+                    fn(objects_[base + count_trailing_zeros(erased)]);
+                    erased &= erased - 1;  // clear lowest set bit
+                }
+            }
+        }
+
+        std::size_t purge() {
+            // Destroys all erased objects and removes them from the table.
+            // Returns the count of destroyed objects.
+            //
+            // Purging invalidates all references to the destroyed objects,
+            // the caller has to remove them from all other containers!
+            // The handles of destroyed objects will never be reused.
+            const std::size_t purged = erased_->count;
+            if (purged == 0) return 0;
+            std::size_t count = 0;
+            for (std::size_t index = 0; index < objects_.size(); ++index) {
+                if (erased_->is_set(index)) continue;
+                Object *object = objects_[index];
+                object->table_index_ = static_cast<uint32_t>(count);
+                objects_[count++] = object;
+            }
+            objects_.resize(count);
+            objects_.shrink_to_fit();
+            for (Bucket &bucket : buckets) {
+                bucket.erase(std::remove_if(
+                        bucket.begin(), bucket.end(),
+                        [](const TableEntry &entry) {
+                            return entry.object->is_erased();
+                        }), bucket.end());  // destroys the objects
+            }
+            erased_->words.assign((objects_.size() + 63) >> 6, 0);
+            erased_->count = 0;
+            ++revision_;
+            return purged;
+        }
+
+        [[nodiscard]] uint64_t revision() const {
+            // Returns the revision of the table, which changes if objects
+            // are stored, erased or purged.
+            return revision_ + erased_->changes;
+        }
+
+        [[nodiscard]] const std::vector<Object *> &handle_order() const {
+            // Returns all not erased objects sorted by handle,
+            // which is a deterministic order independent from the hash table
+            // layout. The order is cached until the table changes.
+            if (handle_order_revision_ != revision()) {
+                handle_order_.clear();
+                handle_order_.reserve(alive_count());
+                for_each_alive([this](Object *object) {
+                    handle_order_.push_back(object);
+                });
+                sort_by_handle(handle_order_);
+                handle_order_revision_ = revision();
+            }
+            return handle_order_;
+        }
+
+        // Iterate over all stored objects in order of insertion.
+        // Does not transfer ownership!
+        [[nodiscard]] const_iterator begin() const { return objects_.cbegin(); }
+
+        [[nodiscard]] const_iterator end() const { return objects_.cend(); }
+
+        [[nodiscard]] Object *at(std::size_t index) const {
+            // Returns the object at the given insertion index, this is meant
+            // to split the table into ranges for parallel processing.
+            return objects_[index];
+        }
+    };
 }
 #endif //EZDXF_OBJECT_TABLE_HPP
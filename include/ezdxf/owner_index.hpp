@@ -0,0 +1,179 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_OWNER_INDEX_HPP
+#define EZDXF_OWNER_INDEX_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+#include "ezdxf/type.hpp"
+#include "ezdxf/object_table.hpp"
+
+namespace ezdxf {
+
+    class Children {
+        // Iterable range of the child objects of an owner:
+        // The children stored in the CSR structure followed by the children
+        // added after building the index. Does not transfer ownership!
+    public:
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Object *;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Object *const *;
+            using reference = Object *const &;
+
+            const_iterator(pointer current, pointer end,
+                           pointer next_begin, pointer next_end) :
+                    current_(current), end_(end),
+                    next_begin_(next_begin), next_end_(next_end) {
+                skip_to_next_range();
+            }
+
+            reference operator*() const { return *current_; }
+
+            const_iterator &operator++() {
+                ++current_;
+                skip_to_next_range();
+                return *this;
+            }
+
+            bool operator==(const const_iterator &other) const {
+                return current_ == other.current_;
+            }
+
+            bool operator!=(const const_iterator &other) const {
+                return current_ != other.current_;
+            }
+
+        private:
+            pointer current_;
+            pointer end_;
+            pointer next_begin_;
+            pointer next_end_;
+
+            void skip_to_next_range() {
+                if (current_ == end_ && next_begin_ != next_end_) {
+                    current_ = next_begin_;
+                    end_ = next_end_;
+                    next_begin_ = next_end_;
+                }
+            }
+        };
+
+        Children() = default;
+
+        Children(Object *const *begin, Object *const *end,
+                 Object *const *added_begin, Object *const *added_end) :
+                begin_(begin), end_(end),
+                added_begin_(added_begin), added_end_(added_end) {}
+
+        [[nodiscard]] std::size_t size() const {
+            return (end_ - begin_) + (added_end_ - added_begin_);
+        }
+
+        [[nodiscard]] bool empty() const { return size() == 0; }
+
+        [[nodiscard]] const_iterator begin() const {
+            return {begin_, end_, added_begin_, added_end_};
+        }
+
+        [[nodiscard]] const_iterator end() const {
+            // The end iterator is the end of the last non-empty range:
+            auto last = added_begin_ != added_end_ ? added_end_ : end_;
+            return {last, last, last, last};
+        }
+
+    private:
+        Object *const *begin_{nullptr};
+        Object *const *end_{nullptr};
+        Object *const *added_begin_{nullptr};
+        Object *const *added_end_{nullptr};
+    };
+
+    class OwnerIndex {
+        // Owner to children index as compressed sparse row (CSR) structure:
+        // The children of all owners are stored in a single contiguous array
+        // grouped by owner, the offset array stores the start index of the
+        // children of each owner, which makes traversing blocks, layouts and
+        // dictionaries O(children) instead of O(document).
+        //
+        // The index is built in one counting sort pass after loading, objects
+        // added later are stored in a separated children list per owner,
+        // until the next rebuild of the index.
+        //
+        // Objects without owner (handle 0) are not indexed.
+    private:
+        static constexpr std::size_t kNoRow = SIZE_MAX;
+        // Maps the owner handle to the CSR row:
+        std::unordered_map<Handle, std::size_t> rows_{};
+        // Row i stores its children at children_[offsets_[i]] up to
+        // children_[offsets_[i + 1]]:
+        std::vector<std::size_t> offsets_{0};
+        std::vector<Object *> children_{};
+        // Children added after building the CSR structure:
+        std::unordered_map<Handle, std::vector<Object *>> added_{};
+
+    public:
+        OwnerIndex() = default;
+
+        template<typename Iterator>
+        void build(Iterator first, Iterator last) {
+            // (Re)build the CSR structure by a counting sort of the objects
+            // in range [first, last) by owner handle.
+            rows_.clear();
+            added_.clear();
+            // 1st pass: assign rows and count children per row, the row of
+            // each object is stored to avoid hashing twice
+            auto counts = std::vector<std::size_t>{};
+            auto object_rows = std::vector<std::size_t>{};
+            for (auto it = first; it != last; ++it) {
+                Handle owner = (*it)->get_owner();
+                if (owner == 0) {
+                    object_rows.push_back(kNoRow);
+                    continue;
+                }
+                auto[row, inserted] = rows_.try_emplace(owner, counts.size());
+                if (inserted) counts.push_back(0);
+                ++counts[row->second];
+                object_rows.push_back(row->second);
+            }
+            // prefix sum of the counts is the offset array:
+            offsets_.assign(counts.size() + 1, 0);
+            for (std::size_t i = 0; i < counts.size(); ++i) {
+                offsets_[i + 1] = offsets_[i] + counts[i];
+            }
+            // 2nd pass: place children, preserves the order of the range
+            children_.resize(offsets_.back());
+            auto next = std::vector<std::size_t>(
+                    offsets_.begin(), offsets_.end() - 1);
+            auto row = object_rows.cbegin();
+            for (auto it = first; it != last; ++it, ++row) {
+                if (*row != kNoRow) children_[next[*row]++] = *it;
+            }
+        }
+
+        template<int N>
+        void build(const ObjectTable<N> &table) {
+            // (Re)build the CSR structure for all objects of the object table.
+            build(table.begin(), table.end());
+        }
+
+        // Add a new object to the index. Invalidates all Children ranges
+        // of the owner of the new object!
+        void add(Object *object);
+
+        [[nodiscard]] Children children(Handle owner) const;
+
+        [[nodiscard]] std::size_t count(Handle owner) const {
+            return children(owner).size();
+        }
+
+        [[nodiscard]] std::size_t owner_count() const;
+    };
+}
+
+#endif //EZDXF_OWNER_INDEX_HPP
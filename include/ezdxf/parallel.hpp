@@ -0,0 +1,131 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_PARALLEL_HPP
+#define EZDXF_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "ezdxf/thread_pool.hpp"
+#include "ezdxf/trace.hpp"
+
+// Parallel algorithms for entity spaces and other random access containers
+// of DXF objects like the results of Document::query().
+//
+// The DXF document has to be frozen, see Document::freeze(), the functions
+// passed to the parallel algorithms must not change the DXF objects!
+
+namespace ezdxf {
+    // Minimum count of elements processed as a single task, splitting
+    // smaller ranges is not worth the task overhead:
+    const std::size_t kMinParallelChunkSize = 1024;
+
+    // Count of chunks per thread for load balancing between threads:
+    const std::size_t kChunksPerThread = 4;
+
+    template<typename Function>
+    void parallel_for(ThreadPool &pool, std::size_t size,
+                      std::size_t chunk_size, Function fn) {
+        // Split the index range [0, size) into chunks of chunk_size and
+        // call fn(chunk, begin, end) for each chunk in parallel. The
+        // calling thread processes tasks until all chunks are done.
+        // The first exception thrown by fn is rethrown in the calling thread.
+        if (size == 0) return;
+        chunk_size = std::max<std::size_t>(1, chunk_size);
+        const std::size_t chunk_count = (size + chunk_size - 1) / chunk_size;
+        std::atomic<std::size_t> remaining{chunk_count};
+        std::exception_ptr error{};
+        std::mutex error_mutex{};
+
+        auto run_chunk = [&, chunk_size, size](std::size_t chunk) {
+            try {
+                auto const span = trace::Span("parallel chunk");
+                const std::size_t begin = chunk * chunk_size;
+                fn(chunk, begin, std::min(size, begin + chunk_size));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+            }
+            --remaining;
+        };
+        for (std::size_t chunk = 1; chunk < chunk_count; ++chunk) {
+            pool.submit([&run_chunk, chunk]() { run_chunk(chunk); });
+        }
+        run_chunk(0);
+        while (remaining > 0) {
+            if (!pool.run_pending_task()) std::this_thread::yield();
+        }
+        if (error) std::rethrow_exception(error);
+    }
+
+    inline std::size_t default_chunk_size(const ThreadPool &pool,
+                                          std::size_t size) {
+        return std::max(kMinParallelChunkSize,
+                        size / (pool.size() * kChunksPerThread) + 1);
+    }
+
+    template<typename Container, typename Function>
+    void parallel_for_each(ThreadPool &pool, const Container &entities,
+                           Function fn) {
+        // Call fn(element) for all elements of a random access container in
+        // parallel, the call order is undefined.
+        auto first = std::begin(entities);
+        const std::size_t size = std::size(entities);
+        parallel_for(pool, size, default_chunk_size(pool, size),
+                     [&fn, first](std::size_t, std::size_t begin,
+                                  std::size_t end) {
+                         for (auto it = first + begin; it != first + end; ++it)
+                             fn(*it);
+                     });
+    }
+
+    template<typename Container, typename Function>
+    void parallel_for_each(const Container &entities, Function fn) {
+        parallel_for_each(ThreadPool::global(), entities, fn);
+    }
+
+    template<typename Container, typename T, typename Map, typename Reduce>
+    T parallel_reduce(ThreadPool &pool, const Container &entities, T init,
+                      Map map, Reduce reduce) {
+        // Returns the reduction of map(element) for all elements of a random
+        // access container in parallel.
+        //
+        // The results of the chunks are reduced in container order, so the
+        // result is deterministic for associative but not commutative
+        // reduce functions. The init value is used as start value of each
+        // chunk and has to be the neutral element of the reduce function!
+        auto first = std::begin(entities);
+        const std::size_t size = std::size(entities);
+        const std::size_t chunk_size = default_chunk_size(pool, size);
+        // optional<T> prevents the std::vector<bool> specialization, which
+        // does not support concurrent writes to different elements:
+        auto results = std::vector<std::optional<T>>(
+                (size + chunk_size - 1) / chunk_size);
+        parallel_for(pool, size, chunk_size,
+                     [&](std::size_t chunk, std::size_t begin,
+                         std::size_t end) {
+                         T result = init;
+                         for (auto it = first + begin; it != first + end; ++it)
+                             result = reduce(result, map(*it));
+                         results[chunk] = result;
+                     });
+        T result = init;
+        for (auto const &value : results) result = reduce(result, *value);
+        return result;
+    }
+
+    template<typename Container, typename T, typename Map, typename Reduce>
+    T parallel_reduce(const Container &entities, T init, Map map,
+                      Reduce reduce) {
+        return parallel_reduce(ThreadPool::global(), entities, init, map,
+                               reduce);
+    }
+}
+
+#endif //EZDXF_PARALLEL_HPP
@@ -0,0 +1,39 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_PROBE_HPP
+#define EZDXF_PROBE_HPP
+
+#include <string>
+#include "ezdxf/type.hpp"
+#include "ezdxf/math/vec3.hpp"
+#include "ezdxf/tag/loader.hpp"
+
+namespace ezdxf {
+    using ezdxf::math::Vec3;
+
+    struct HeaderInfo {
+        // Inventory information of the HEADER section, missing header
+        // variables have the default values.
+        bool valid{false};  // HEADER section found
+        String acadver{};  // $ACADVER as stored
+        Version version{Version::R12};  // $ACADVER as enum
+        Handle handseed{0};  // $HANDSEED
+        bool has_extents{false};  // $EXTMIN and $EXTMAX found
+        Vec3 extmin{0, 0, 0};  // $EXTMIN
+        Vec3 extmax{0, 0, 0};  // $EXTMAX
+        int insunits{0};  // $INSUNITS, 0 is unitless
+        String codepage{};  // $DWGCODEPAGE e.g. "ANSI_1252"
+    };
+
+    // Load only the HEADER section, which has to be the first section of
+    // the DXF data. Stops loading at the end of the HEADER section or at
+    // the first structure tag of another section, therefore only the first
+    // kilobytes of a DXF file are read.
+    HeaderInfo probe(tag::AscLoader &loader);
+
+    // Returns an invalid HeaderInfo if the file does not exist:
+    HeaderInfo probe(const std::string &filename);
+}
+
+#endif //EZDXF_PROBE_HPP
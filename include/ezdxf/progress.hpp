@@ -0,0 +1,42 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_PROGRESS_HPP
+#define EZDXF_PROGRESS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace ezdxf {
+    // Default count of bytes between two progress reports:
+    const std::size_t kDefaultProgressInterval = 1 << 20;
+
+    struct LoadProgress {
+        std::size_t bytes{0};  // bytes consumed from the input stream
+        std::size_t line_number{0};
+        std::size_t entities{0};  // count of loaded graphical entities
+    };
+
+    // The callback is called by the loading thread:
+    using ProgressCallback = std::function<void(const LoadProgress &)>;
+
+    class CancellationToken {
+        // Cooperative cancellation: copies of a token share the same state,
+        // cancel() can be called by any thread, the loader checks the token
+        // for each loaded tag or DXF object.
+    private:
+        std::shared_ptr<std::atomic<bool>> cancelled_{
+                std::make_shared<std::atomic<bool>>(false)};
+
+    public:
+        void cancel() { cancelled_->store(true, std::memory_order_relaxed); }
+
+        [[nodiscard]] bool is_cancelled() const {
+            return cancelled_->load(std::memory_order_relaxed);
+        }
+    };
+}
+
+#endif //EZDXF_PROGRESS_HPP
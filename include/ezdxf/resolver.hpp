@@ -0,0 +1,93 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_RESOLVER_HPP
+#define EZDXF_RESOLVER_HPP
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+#include "ezdxf/type.hpp"
+#include "ezdxf/object_table.hpp"
+#include "ezdxf/parallel.hpp"
+
+namespace ezdxf {
+    // Minimum count of objects processed by a single thread, splitting
+    // smaller tables is not worth the thread overhead:
+    const std::size_t kMinResolverChunkSize = 4096;
+
+    void log_dangling_owner(ErrorMessages &errors, const Object *object);
+
+    void log_dangling_pointer(ErrorMessages &errors, const Object *object,
+                              const acdb::Reference &ref);
+
+    inline bool is_ignored(const std::vector<Handle> *ignored,
+                           Handle handle) {
+        return ignored &&
+               std::binary_search(ignored->begin(), ignored->end(), handle);
+    }
+
+    template<int N>
+    void resolve_object_references(
+            const ObjectTable<N> &table, Object *object, ErrorMessages &errors,
+            const std::vector<Handle> *ignored = nullptr) {
+        // Resolve the owner handle and all pointer references of a single
+        // object. Writes only to the given object and the given error log,
+        // the object table is not modified.
+        //
+        // Dangling handles in the sorted ignored handles are not logged,
+        // e.g. handles of entities skipped by selective loading.
+        if (Handle owner = object->get_owner(); owner) {
+            Object *owner_object = table.get(owner);
+            object->set_owner_object(owner_object);
+            if (!owner_object && !is_ignored(ignored, owner))
+                log_dangling_owner(errors, object);
+        }
+        for (auto &ref : object->get_references()) {
+            ref.object = ref.handle ? table.get(ref.handle) : nullptr;
+            // The "0" handle is a valid value for "no reference":
+            if (ref.handle && !ref.object && !is_ignored(ignored, ref.handle))
+                log_dangling_pointer(errors, object, ref);
+        }
+    }
+
+    template<int N>
+    ErrorMessages resolve_references(
+            const ObjectTable<N> &table,
+            ThreadPool &pool = ThreadPool::global(),
+            const std::vector<Handle> *ignored = nullptr) {
+        // Post-load stage: resolve owner handles and pointer references of
+        // all objects to object pointers, so later traversals never have to
+        // hash again.
+        //
+        // The object table has to be read-only while resolving, because the
+        // objects are processed in parallel. Each chunk is a contiguous range
+        // of objects and has its own error log, the logs are merged in range
+        // order, therefore the audit findings do not depend on thread
+        // scheduling.
+        //
+        // Returns dangling owner handles and dangling pointer references as
+        // audit findings.
+        const std::size_t size = table.size();
+        const std::size_t chunk_size = std::max(
+                kMinResolverChunkSize, size / pool.size() + 1);
+        auto logs = std::vector<ErrorMessages>(
+                (size + chunk_size - 1) / chunk_size);
+        parallel_for(pool, size, chunk_size,
+                     [&table, &logs, ignored](std::size_t chunk,
+                                              std::size_t begin,
+                                              std::size_t end) {
+                         for (std::size_t i = begin; i < end; ++i) {
+                             resolve_object_references(
+                                     table, table.at(i), logs[chunk], ignored);
+                         }
+                     });
+        ErrorMessages errors{};
+        for (auto &log : logs) {
+            std::move(log.begin(), log.end(), std::back_inserter(errors));
+        }
+        return errors;
+    }
+}
+
+#endif //EZDXF_RESOLVER_HPP
@@ -0,0 +1,120 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_SNAPSHOT_HPP
+#define EZDXF_SNAPSHOT_HPP
+
+#include <cstdint>
+#include "ezdxf/type.hpp"
+
+namespace ezdxf::snapshot {
+    // Binary snapshot format of a loaded DXF document, see
+    // Document::save_snapshot().
+    //
+    // The snapshot is a header followed by the payload. The payload starts
+    // with a directory of the record arrays, all offsets are relative to the
+    // start of the payload and all records have a fixed size and are
+    // aligned to 8 bytes, therefore the payload can be used in place, e.g.
+    // from a memory mapped file. All strings (section names, object names,
+    // layers and tag values) are stored in a single string arena at the
+    // end of the payload.
+    //
+    // The data is stored in the native byte order, the byte order mark of
+    // the header rejects snapshots of other platforms.
+
+    const char kMagic[8] = {'E', 'Z', 'D', 'X', 'F', 'S', 'N', 'P'};
+    const uint32_t kVersion = 2;
+
+    enum class ObjectKind : uint32_t {
+        kObject,  // acdb::Object
+        kRawObject,  // acdb::RawObject
+        kEntity,  // acdb::Entity
+    };
+
+    // ObjectRecord flags:
+    const uint32_t kLoaded = 1;  // object has raw tags
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint64_t payload_size;  // count of bytes following the header
+        uint64_t checksum;  // FNV-1a hash of the payload
+    };
+
+    struct Array {
+        uint64_t offset;
+        uint64_t count;
+    };
+
+    struct Directory {
+        Array sections;
+        Array objects;
+        Array tags;
+        Array references;
+        Array errors;
+        Array arena;  // count of bytes
+        uint64_t max_handle;  // handle counter of the object table
+        // Sorted handles in use, which are not stored in the object table:
+        Array skipped;  // handles of entities skipped by selective loading
+        Array sequence_handles;  // handles of VERTEX and SEQEND entities
+    };
+
+    struct StringRef {
+        uint64_t offset;  // into the string arena
+        uint64_t size;
+    };
+
+    struct SectionRecord {
+        StringRef name;
+        uint64_t first_tag;
+        uint64_t tag_count;
+        uint64_t first_object;
+        uint64_t object_count;
+    };
+
+    struct ObjectRecord {
+        Handle handle;
+        Handle owner;
+        StringRef name;
+        StringRef layer;
+        uint64_t first_tag;
+        uint64_t tag_count;
+        uint64_t first_reference;
+        uint64_t reference_count;
+        ObjectKind kind;
+        DXFType type;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    struct TagRecord {
+        StringRef value;
+        int32_t code;
+        uint32_t reserved;
+    };
+
+    struct ReferenceRecord {
+        Handle handle;
+        int32_t code;
+        uint32_t reserved;
+    };
+
+    struct ErrorRecord {
+        StringRef message;
+        ErrorCode code;
+        uint32_t reserved;
+    };
+
+    // The records are written as raw memory, any padding would store
+    // undefined bytes:
+    static_assert(sizeof(Header) == 32);
+    static_assert(sizeof(Directory) == 136);
+    static_assert(sizeof(SectionRecord) == 48);
+    static_assert(sizeof(ObjectRecord) == 96);
+    static_assert(sizeof(TagRecord) == 24);
+    static_assert(sizeof(ReferenceRecord) == 16);
+    static_assert(sizeof(ErrorRecord) == 24);
+}
+
+#endif //EZDXF_SNAPSHOT_HPP
@@ -0,0 +1,45 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_SPAN_HPP
+#define EZDXF_SPAN_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace ezdxf {
+
+    template<typename T>
+    class Span {
+        // Read-only view of contiguous elements like the std::span of C++20.
+        // The span does not own the elements, the viewed container has to
+        // outlive the span and must not be resized.
+    private:
+        const T *data_{nullptr};
+        std::size_t size_{0};
+
+    public:
+        using const_iterator = const T *;
+
+        Span() = default;
+
+        Span(const T *data, std::size_t size) : data_(data), size_(size) {}
+
+        explicit Span(const std::vector<T> &v) :
+                data_(v.data()), size_(v.size()) {}
+
+        [[nodiscard]] const T *data() const { return data_; }
+
+        [[nodiscard]] std::size_t size() const { return size_; }
+
+        [[nodiscard]] bool empty() const { return size_ == 0; }
+
+        const T &operator[](std::size_t index) const { return data_[index]; }
+
+        [[nodiscard]] const_iterator begin() const { return data_; }
+
+        [[nodiscard]] const_iterator end() const { return data_ + size_; }
+    };
+}
+
+#endif //EZDXF_SPAN_HPP
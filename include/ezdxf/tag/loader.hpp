@@ -4,7 +4,9 @@
 #ifndef EZDXF_TAG_LOADER_HPP
 #define EZDXF_TAG_LOADER_HPP
 
+#include <array>
 #include <istream>
+#include <utility>
 #include <vector>
 #include "ezdxf/tag/tag.hpp"
 
@@ -35,6 +37,11 @@ namespace ezdxf::tag {
         // Current loaded tag -- is an error tag if EOF is reached:
         StringTag current{GroupCode::kStructure};
         size_t line_number = 0;
+        // Count of bytes read from the input stream and the byte offset of
+        // the current tag in the input stream, this is the byte offset of
+        // the group code line:
+        size_t offset = 0;
+        size_t current_offset = 0;
         ErrorMessages errors{};
 
         StringTag load_next();
@@ -44,6 +51,10 @@ namespace ezdxf::tag {
     public:
         explicit BasicLoader(const String &);
 
+        // Load from an external stream, the stream is not owned by the
+        // loader and has to exist as long as the loader:
+        explicit BasicLoader(std::istream &);
+
         ~BasicLoader();
 
         [[nodiscard]] const StringTag &peek() const {
@@ -58,6 +69,11 @@ namespace ezdxf::tag {
 
         [[nodiscard]] size_t get_line_number() const { return line_number; }
 
+        // Returns the byte offset of the current tag, returns the count of
+        // read bytes at the end of the input stream. Skipped comment tags
+        // are located in front of the current tag.
+        [[nodiscard]] size_t get_offset() const { return current_offset; }
+
         [[nodiscard]] bool has_errors() const { return !errors.empty(); }
 
         [[nodiscard]] const ErrorMessages &get_errors() const { return errors; }
@@ -88,11 +104,12 @@ namespace ezdxf::tag {
         StringTag current{GroupCode::kStructure, ""};
         size_t line_number = 0;
         ErrorMessages errors{};
+        // Count of loaded tags by the tag type of the group code, the y- and
+        // z-axis of vectors are counted as kReal:
+        std::array<size_t, kTagTypeCount> tag_counts{};
 
         void load_next_tag();
 
-        [[nodiscard]] size_t get_line_number() const { return line_number; };
-
         void log_invalid_real_value();
 
         void log_invalid_integer_value();
@@ -106,10 +123,32 @@ namespace ezdxf::tag {
 
         [[nodiscard]] TagType detect_current_type() const override;
 
+        [[nodiscard]] size_t get_line_number() const { return line_number; };
+
+        // Returns the count of bytes consumed from the input stream, this
+        // includes the bytes of the current tag:
+        [[nodiscard]] size_t get_offset() const { return loader.get_offset(); }
+
+        [[nodiscard]] const std::array<size_t, kTagTypeCount> &
+        get_tag_counts() const { return tag_counts; }
+
         [[nodiscard]] bool eof() const override {
             return current.is_error_tag();
         }
 
+        // Untyped access to the raw string tags, required to load the
+        // DXF structure and to preserve unknown tags:
+        [[nodiscard]] const StringTag &peek() const { return current; }
+
+        StringTag get() {  // returns loaded string tags by value!
+            auto tag = std::move(current);
+            load_next_tag();
+            return tag;
+        }
+
+        // Skip the current tag without returning it:
+        void skip() { load_next_tag(); }
+
         std::unique_ptr<DXFTag> string_tag() override;
 
         std::unique_ptr<DXFTag> binary_tag() override;
@@ -4,6 +4,7 @@
 #ifndef EZDXF_TAG_TAG_HPP
 #define EZDXF_TAG_TAG_HPP
 
+#include <memory>
 #include <utility>
 #include <vector>
 #include <typeinfo>
@@ -34,6 +35,10 @@ namespace ezdxf::tag {
         kUndefined = 0, kString, kInteger, kReal, kVec3, kVec2, kBinaryData
     };
 
+    // Count of TagType enums, has to be updated if new types are added:
+    constexpr std::size_t kTagTypeCount =
+            static_cast<std::size_t>(TagType::kBinaryData) + 1;
+
     class DXFTag {
         // The abstract base class which is the foundation of the DXF tag type
         // system. The DXFTag type provides already the full functionality, but
@@ -161,6 +166,9 @@ namespace ezdxf::tag {
             return value_;
         }
 
+        // Returns the value without copying, e.g. for bulk parsers:
+        [[nodiscard]] const String &str() const { return value_; }
+
         [[nodiscard]] TagType type() const override {
             return TagType::kString;
         }
@@ -278,6 +286,10 @@ namespace ezdxf::tag {
 
     };
 
+    // Raw DXF tags as loaded from the file, preserves all data of DXF
+    // objects which are not decoded into typed members:
+    using StringTags = std::vector<StringTag>;
+
     TagType group_code_type(int);
 
     bool is_valid_group_code(int64_t);
@@ -0,0 +1,35 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_TAG_WRITER_HPP
+#define EZDXF_TAG_WRITER_HPP
+
+#include <ostream>
+#include "ezdxf/tag/tag.hpp"
+
+namespace ezdxf::tag {
+
+    class AscWriter {
+        // Basic ASCII DXF tag writer, writes string tags to a generic char
+        // output stream. The stream is not owned by the writer.
+    private:
+        std::ostream &output_stream;
+
+    public:
+        explicit AscWriter(std::ostream &stream) : output_stream(stream) {}
+
+        void write(int code, const String &value);
+
+        void write(const StringTag &tag) {
+            write(tag.group_code(), tag.string());
+        }
+
+        void write_handle(int code, Handle handle);
+
+        void write_real(int code, Real value);
+
+        void write_integer(int code, int64_t value);
+    };
+}
+
+#endif //EZDXF_TAG_WRITER_HPP
@@ -0,0 +1,74 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_THREAD_POOL_HPP
+#define EZDXF_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ezdxf {
+
+    class ThreadPool {
+        // Work stealing thread pool:
+        // Each worker has its own task queue, tasks submitted by a worker are
+        // added to its own queue, tasks submitted by other threads are
+        // distributed round robin. Idle workers take tasks from the back of
+        // their own queue and steal tasks from the front of the other queues.
+        //
+        // Waiting threads should help processing tasks by run_pending_task(),
+        // this prevents deadlocks for tasks which submit and wait for
+        // nested tasks.
+    public:
+        using Task = std::function<void()>;
+
+        // The default thread count is the count of hardware threads:
+        explicit ThreadPool(unsigned int thread_count = 0);
+
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        [[nodiscard]] unsigned int size() const {
+            // The queues are complete before the first worker starts, the
+            // workers_ vector is still growing while the workers run:
+            return static_cast<unsigned int>(queues_.size());
+        }
+
+        void submit(Task task);
+
+        // Executes one pending task in the calling thread.
+        // Returns false if no task was pending.
+        bool run_pending_task();
+
+        // Shared pool for all parallel algorithms of the library:
+        static ThreadPool &global();
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+        std::vector<std::unique_ptr<Queue>> queues_{};
+        std::vector<std::thread> workers_{};
+        std::mutex wake_mutex_{};
+        std::condition_variable wake_{};
+        std::atomic<std::size_t> pending_{0};  // count of queued tasks
+        std::atomic<unsigned int> next_queue_{0};
+        bool stop_{false};  // guarded by wake_mutex_
+
+        void work(unsigned int index);
+
+        bool pop_task(unsigned int index, Task &task);
+    };
+}
+
+#endif //EZDXF_THREAD_POOL_HPP
@@ -0,0 +1,90 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_TRACE_HPP
+#define EZDXF_TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <string>
+
+// Timeline tracing of loading and exporting stages, the recorded spans are
+// written in the Chrome trace event format, which can be visualized by
+// chrome://tracing or https://ui.perfetto.dev
+//
+// Tracing is disabled by default, a disabled Span costs a single atomic
+// load. Each thread records into its own buffer.
+
+namespace ezdxf::trace {
+    namespace detail {
+        extern std::atomic<bool> enabled;
+
+        void record(const char *name, std::string detail,
+                    std::chrono::steady_clock::time_point begin,
+                    std::chrono::steady_clock::time_point end);
+    }
+
+    // Removes all recorded spans and starts recording:
+    void start();
+
+    // Stops recording, spans already started are still recorded at their
+    // end:
+    void stop();
+
+    [[nodiscard]] inline bool is_enabled() {
+        return detail::enabled.load(std::memory_order_relaxed);
+    }
+
+    // Count of recorded spans of all threads:
+    [[nodiscard]] std::size_t size();
+
+    // Names the current thread in the trace output:
+    void set_thread_name(const std::string &name);
+
+    // Writes all recorded spans as Chrome trace JSON, recording should be
+    // stopped:
+    void write_chrome_trace(std::ostream &stream);
+
+    bool write_chrome_trace(const std::string &filename);
+
+    class Span {
+        // Records the lifetime of the Span object as a trace span if tracing
+        // is enabled at construction. The name has to be a string literal
+        // or a string with static lifetime, the optional detail is shown as
+        // argument of the span.
+    private:
+        const char *name_{nullptr};  // nullptr if tracing is disabled
+        std::string detail_{};
+        std::chrono::steady_clock::time_point begin_{};
+
+    public:
+        explicit Span(const char *name) {
+            if (is_enabled()) {
+                name_ = name;
+                begin_ = std::chrono::steady_clock::now();
+            }
+        }
+
+        Span(const char *name, const std::string &detail) {
+            if (is_enabled()) {
+                name_ = name;
+                detail_ = detail;
+                begin_ = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~Span() {
+            if (name_) {
+                detail::record(name_, std::move(detail_), begin_,
+                               std::chrono::steady_clock::now());
+            }
+        }
+
+        Span(const Span &) = delete;
+
+        Span &operator=(const Span &) = delete;
+    };
+}
+
+#endif //EZDXF_TRACE_HPP
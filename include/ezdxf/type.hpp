@@ -5,6 +5,7 @@
 #define EZDXF_TYPE_HPP
 
 #include <cassert>
+#include <cstdint>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -17,6 +18,12 @@ namespace ezdxf {
         kInvalidIntegerTag,
         kInvalidRealTag,
         kInvalidBinaryTag,
+        kDanglingOwnerHandle,
+        kDanglingPointerHandle,
+        kInvalidHandle,
+        kDuplicateHandle,
+        kInvalidStructure,
+        kLoadingCancelled,
     };
 
     struct ErrorMessage {
@@ -69,15 +76,31 @@ namespace ezdxf {
         AttDef,
         Attrib,
         Circle,
+        Dimension,
         Ellipse,
+        Face3d,
+        Hatch,
+        Insert,
         Line,
         LwPolyline,
+        Mesh,
+        MText,
         Point,
         Polyline,
+        Ray,
+        SeqEnd,
+        Solid,
         Spline,
         Text,
+        Trace,
+        Vertex,
+        Viewport,
+        XLine,
     };
 
+    // Count of DXFType enums, has to be updated if new types are added:
+    constexpr std::size_t kDXFTypeCount =
+            static_cast<std::size_t>(DXFType::XLine) + 1;
 
     // The DXF type does not always show the complete entity type.
     // e.g. the DXF type "POLYLINE" can represent an AcDb2dPolyline,
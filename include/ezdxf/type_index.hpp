@@ -0,0 +1,71 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#ifndef EZDXF_TYPE_INDEX_HPP
+#define EZDXF_TYPE_INDEX_HPP
+
+#include <array>
+#include <vector>
+#include "ezdxf/type.hpp"
+#include "ezdxf/object_table.hpp"
+
+namespace ezdxf {
+
+    class TypeIndex {
+        // Stores the entities of each DXF type in a separated contiguous
+        // array, which makes queries like "all CIRCLE entities" a linear
+        // scan over a dense array instead of a walk over the whole object
+        // table with a virtual dxf_type() call for each object.
+        //
+        // The entities are stored in order of insertion. Objects of type
+        // DXFType::None are not indexed.
+        //
+        // Removed entities are collected and the array of a type is
+        // compacted once by the next access, which makes erasing many
+        // entities linear instead of quadratic.
+    private:
+        mutable std::array<std::vector<Object *>, kDXFTypeCount> index_{};
+        // Removed entities of each type, which are not compacted yet:
+        mutable std::array<std::vector<Object *>, kDXFTypeCount> removed_{};
+
+        void compact(std::size_t type_index) const;
+
+        [[nodiscard]] static std::size_t index(DXFType type) {
+            return static_cast<std::size_t>(type);
+        }
+
+    public:
+        TypeIndex() = default;
+
+        template<int N>
+        void build(const ObjectTable<N> &table) {
+            // (Re)build the index for all objects of the object table.
+            clear();
+            for (auto const object : table) add(object);
+        }
+
+        void clear();
+
+        void add(Object *object);
+
+        void remove(Object *object);
+
+        // Compacts the arrays of all types, the const access is thread safe
+        // afterwards until the next remove() call.
+        void compact();
+
+        // Returns all indexed entities of the given DXF type.
+        // Does not transfer ownership!
+        [[nodiscard]] const std::vector<Object *> &get(DXFType type) const {
+            auto const i = index(type);
+            if (!removed_[i].empty()) compact(i);
+            return index_[i];
+        }
+
+        [[nodiscard]] std::size_t count(DXFType type) const {
+            return get(type).size();
+        }
+    };
+}
+
+#endif //EZDXF_TYPE_INDEX_HPP
@@ -29,6 +29,16 @@ namespace ezdxf::utils {
 
     int safe_group_code(const String &s);
 
+    // Handles are stored as hex strings in DXF files:
+    std::optional<Handle> safe_str_to_handle(const String &s);
+
+    // Returns uppercase hex chars:
+    String handle_to_str(Handle h);
+
+    // Returns the shortest string which loads as the same value, e.g. to
+    // export decoded real values:
+    String real_to_str(Real value);
+
     // Utility functions to manage binary data in binary tags with
     // group codes 310-319 & 1004.
     String hexlify(const Bytes &data);
@@ -37,10 +47,22 @@ namespace ezdxf::utils {
 
     Bytes concatenate_bytes(const std::vector<Bytes> &data);
 
+    // 64-bit FNV-1a hash, for checksums and not for cryptographic purpose,
+    // call with the previous hash value as seed to hash multiple blocks:
+    const uint64_t kFNVOffsetBasis = 0xcbf29ce484222325;
+
+    uint64_t fnv1a_hash(const char *data, std::size_t size,
+                        uint64_t seed = kFNVOffsetBasis);
+
     String dxf_version_to_str(Version v);
 
     Version str_to_dxf_version(String s);
 
+    String dxf_type_to_str(DXFType t);
+
+    // Returns DXFType::None for unsupported types:
+    DXFType str_to_dxf_type(const String &s);
+
     extern const SimpleSet<Version> DXFExportVersions;
 }
 #endif //EZDXF_UTILS_HPP
@@ -0,0 +1,51 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include "ezdxf/acdb/columnar.hpp"
+#include "ezdxf/tag/writer.hpp"
+#include "ezdxf/utils.hpp"
+
+namespace ezdxf::acdb {
+
+    ColumnarEntity::ColumnarEntity(Entity &&entity, tag::StringTags tags,
+                                   GeometryColumns &columns,
+                                   const std::size_t row,
+                                   const Positions &positions) :
+            Entity(std::move(entity)), columns_(&columns), row_(row),
+            positions_(positions) {
+        set_raw_tags(std::move(tags));
+    }
+
+    Real ColumnarEntity::value(const int code) const {
+        return columns_->column(code)[row_];
+    }
+
+    void ColumnarEntity::set_value(const int code, const Real value) {
+        columns_->column_data(code)[row_] = value;
+    }
+
+    void ColumnarEntity::export_decoded_tags(tag::AscWriter &writer,
+                                             const std::size_t index) const {
+        auto const &groups = columns_->groups();
+        for (std::size_t group = 0; group < groups.size(); ++group) {
+            if (positions_[group] != index) continue;
+            for (auto const code : groups[group])
+                writer.write_real(code, value(code));
+        }
+    }
+
+    void ColumnarEntity::for_each_tag(
+            const std::function<void(const tag::StringTag &)> &fn) const {
+        auto const &groups = columns_->groups();
+        auto const &tags = get_raw_tags();
+        for (std::size_t index = 0; index <= tags.size(); ++index) {
+            for (std::size_t group = 0; group < groups.size(); ++group) {
+                if (positions_[group] != index) continue;
+                for (auto const code : groups[group]) {
+                    fn(tag::StringTag(code, utils::real_to_str(value(code))));
+                }
+            }
+            if (index < tags.size()) fn(tags[index]);
+        }
+    }
+}
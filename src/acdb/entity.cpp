@@ -0,0 +1,60 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include "ezdxf/acdb/entity.hpp"
+#include "ezdxf/tag/writer.hpp"
+
+namespace ezdxf::acdb {
+
+    void RawObject::export_dxf(tag::AscWriter &writer) const {
+        writer.write(0, name_);
+        if (!loaded_) export_new_object_tags(writer);
+        bool has_owner = false;
+        bool app_data = false;
+        for (std::size_t index = 0; index < tags_.size(); ++index) {
+            export_decoded_tags(writer, index);
+            auto const &tag = tags_[index];
+            int code = tag.group_code();
+            if (code == 5 || code == 105) {
+                writer.write_handle(code, get_handle());
+            } else if (code == 330 && !has_owner && !app_data) {
+                // The first soft-pointer outside of application defined
+                // data is the owner handle:
+                writer.write_handle(330, get_owner());
+                has_owner = true;
+            } else {
+                if (code == 102) {
+                    app_data = !tag.string().empty() &&
+                               tag.string()[0] == '{';
+                }
+                export_raw_tag(writer, tag);
+            }
+        }
+        export_decoded_tags(writer, tags_.size());
+    }
+
+    void RawObject::export_new_object_tags(tag::AscWriter &writer) const {
+        writer.write_handle(5, get_handle());
+        if (get_owner()) writer.write_handle(330, get_owner());
+    }
+
+    void RawObject::export_raw_tag(tag::AscWriter &writer,
+                                   const tag::StringTag &tag) const {
+        writer.write(tag);
+    }
+
+    void Entity::export_new_object_tags(tag::AscWriter &writer) const {
+        RawObject::export_new_object_tags(writer);
+        writer.write(100, "AcDbEntity");
+        writer.write(8, layer_);
+    }
+
+    void Entity::export_raw_tag(tag::AscWriter &writer,
+                                const tag::StringTag &tag) const {
+        if (tag.group_code() == 8) {
+            writer.write(8, layer_);
+        } else {
+            writer.write(tag);
+        }
+    }
+}
@@ -0,0 +1,169 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <sstream>
+#include "ezdxf/acdb/factory.hpp"
+#include "ezdxf/acdb/entity.hpp"
+#include "ezdxf/acdb/lwpolyline.hpp"
+#include "ezdxf/acdb/mesh.hpp"
+#include "ezdxf/acdb/polyline.hpp"
+#include "ezdxf/utils.hpp"
+
+namespace ezdxf::acdb {
+
+    static void log_invalid_handle(ErrorMessages &errors,
+                                   std::size_t line_number) {
+        std::ostringstream msg;
+        msg << "Invalid handle in line " << line_number;
+        errors.emplace_back(ErrorCode::kInvalidHandle, msg.str());
+    }
+
+    static std::unique_ptr<RawObject> create_object(const String &name) {
+        auto type = utils::str_to_dxf_type(name);
+        switch (type) {
+            case DXFType::None:
+                return std::make_unique<RawObject>(name);
+            case DXFType::LwPolyline:
+                return std::make_unique<LwPolyline>();
+            case DXFType::Mesh:
+                return std::make_unique<Mesh>();
+            case DXFType::Polyline:
+                return std::make_unique<Polyline>();
+            default:
+                return std::make_unique<Entity>(type, name);
+        }
+    }
+
+    class TagDecoder {
+        // Decodes the handle, owner handle, pointer references and the
+        // layer of a DXF object from its raw tags.
+    private:
+        RawObject *object_;
+        Entity *entity_;
+        bool has_owner_ = false;
+        bool app_data_ = false;
+
+    public:
+        explicit TagDecoder(RawObject *object) :
+                object_(object), entity_(dynamic_cast<Entity *>(object)) {}
+
+        void decode(const tag::StringTag &tag, ErrorMessages &errors,
+                    std::size_t line_number) {
+            int code = tag.group_code();
+            if (code == 5 || code == 105) {
+                // 105 is the handle of the DIMSTYLE table entry
+                auto handle = utils::safe_str_to_handle(tag.string());
+                if (handle) {
+                    // Ignore multiple handle tags, the handle is immutable:
+                    if (!object_->get_handle())
+                        object_->set_handle(handle.value());
+                } else log_invalid_handle(errors, line_number);
+            } else if (code == 102) {
+                // Application defined data: (102, "{NAME") ... (102, "}")
+                auto const value = tag.string();
+                app_data_ = !value.empty() && value[0] == '{';
+            } else if (acdb::is_pointer_group_code(code)) {
+                auto handle = utils::safe_str_to_handle(tag.string());
+                if (!handle) {
+                    log_invalid_handle(errors, line_number);
+                } else if (code == 330 && !has_owner_ && !app_data_) {
+                    // The first soft-pointer outside of application defined
+                    // data is the owner handle:
+                    object_->set_owner(handle.value());
+                    has_owner_ = true;
+                } else {
+                    object_->add_reference(code, handle.value());
+                }
+            } else if (code == 8 && entity_) {
+                entity_->set_layer(tag.string());
+            }
+        }
+    };
+
+    static std::unique_ptr<Object> load_lwpolyline(tag::AscLoader &loader,
+                                                   ErrorMessages &errors) {
+        // Specialized loader for LWPOLYLINE entities with many vertices,
+        // the vertex tags are decoded in bulk without storing raw tags.
+        loader.skip();  // (0, LWPOLYLINE)
+        auto polyline = std::make_unique<LwPolyline>();
+        auto decoder = TagDecoder(polyline.get());
+        auto tags = tag::StringTags{};
+        bool has_vertices = false;
+        while (!loader.eof() &&
+               loader.peek().group_code() != tag::GroupCode::kStructure) {
+            int code = loader.peek().group_code();
+            if (code == 10 && !has_vertices) {
+                polyline->load_vertices(loader, tags.size(), errors);
+                has_vertices = true;
+                continue;
+            }
+            if (code == 90 && !has_vertices)
+                polyline->presize(loader.peek().str());
+            tags.push_back(loader.get());
+            decoder.decode(tags.back(), errors, loader.get_line_number());
+        }
+        // A polyline without vertices exports new vertices at the end:
+        if (!has_vertices) polyline->load_vertices(loader, tags.size(), errors);
+        polyline->set_raw_tags(std::move(tags));
+        return polyline;
+    }
+
+    static std::unique_ptr<Object> load_mesh(tag::AscLoader &loader,
+                                             ErrorMessages &errors) {
+        // Specialized loader for MESH entities, the data blocks of the
+        // AcDbSubDMesh subclass are decoded in bulk without storing raw tags.
+        loader.skip();  // (0, MESH)
+        auto mesh = std::make_unique<Mesh>();
+        auto decoder = TagDecoder(mesh.get());
+        auto tags = tag::StringTags{};
+        bool subclass = false;  // (100, AcDbSubDMesh) is loaded
+        while (!loader.eof() &&
+               loader.peek().group_code() != tag::GroupCode::kStructure) {
+            if (subclass && mesh->is_next_block(loader.peek().group_code())) {
+                mesh->load_block(loader, tags.size(), errors);
+                continue;
+            }
+            if (loader.peek().equals(100, "AcDbSubDMesh")) subclass = true;
+            tags.push_back(loader.get());
+            decoder.decode(tags.back(), errors, loader.get_line_number());
+        }
+        mesh->set_raw_tags(std::move(tags));
+        return mesh;
+    }
+
+    std::unique_ptr<Object> load_object(tag::AscLoader &loader,
+                                        ErrorMessages &errors) {
+        if (loader.peek().str() == "LWPOLYLINE")
+            return load_lwpolyline(loader, errors);
+        if (loader.peek().str() == "MESH") return load_mesh(loader, errors);
+        auto object = create_object(loader.get().string());
+        auto decoder = TagDecoder(object.get());
+        auto tags = tag::StringTags{};
+        while (!loader.eof() &&
+               loader.peek().group_code() != tag::GroupCode::kStructure) {
+            tags.push_back(loader.get());
+            decoder.decode(tags.back(), errors, loader.get_line_number());
+        }
+        object->set_raw_tags(std::move(tags));
+        // The VERTEX and SEQEND entities are part of the POLYLINE:
+        if (auto polyline = dynamic_cast<Polyline *>(object.get()))
+            polyline->load_sequence(loader, errors);
+        return object;
+    }
+
+    std::unique_ptr<Object> load_object(const String &name,
+                                        tag::StringTags tags,
+                                        ErrorMessages &errors,
+                                        std::size_t line_number) {
+        auto object = create_object(name);
+        auto decoder = TagDecoder(object.get());
+        for (auto const &tag : tags) {
+            // Embedded entities like the VERTEX entities of a POLYLINE are
+            // decoded by load_tags():
+            if (tag.group_code() == tag::GroupCode::kStructure) break;
+            decoder.decode(tag, errors, line_number);
+        }
+        object->load_tags(std::move(tags), errors, line_number);
+        return object;
+    }
+}
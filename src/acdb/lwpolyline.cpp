@@ -0,0 +1,196 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include "ezdxf/acdb/lwpolyline.hpp"
+#include "ezdxf/tag/writer.hpp"
+#include "ezdxf/utils.hpp"
+
+namespace ezdxf::acdb {
+
+    static void log_invalid_vertex_value(ErrorMessages &errors,
+                                         std::size_t line_number) {
+        std::ostringstream msg;
+        msg << "Invalid LWPOLYLINE vertex value in line " << line_number;
+        errors.emplace_back(ErrorCode::kInvalidRealTag, msg.str());
+    }
+
+    static void set_optional(std::vector<Real> &column,
+                             const std::size_t size, const Real value) {
+        // Sets the value of the last vertex, the column is allocated for
+        // the first value != 0:
+        if (column.empty() && value == 0.0) return;
+        column.resize(size, 0.0);
+        column.back() = value;
+    }
+
+    static Real get_optional(const std::vector<Real> &column,
+                             const std::size_t index) {
+        return index < column.size() ? column[index] : 0.0;
+    }
+
+    void LwPolyline::reserve(const std::size_t count) {
+        // The optional columns are not reserved, most polylines have no
+        // widths and bulges:
+        x_.reserve(count);
+        y_.reserve(count);
+    }
+
+    void LwPolyline::presize(const String &count) {
+        auto const value = utils::safe_str_to_int64(count);
+        if (value && value.value() > 0) {
+            reserve(std::min(static_cast<std::size_t>(value.value()),
+                             kMaxPresize));
+        }
+    }
+
+    void LwPolyline::clear() {
+        x_.clear();
+        y_.clear();
+        start_width_.clear();
+        end_width_.clear();
+        bulge_.clear();
+        identifiers_.clear();
+    }
+
+    void LwPolyline::append(Real x, Real y, Real start_width, Real end_width,
+                            Real bulge) {
+        x_.push_back(x);
+        y_.push_back(y);
+        auto const count = x_.size();
+        set_optional(start_width_, count, start_width);
+        set_optional(end_width_, count, end_width);
+        set_optional(bulge_, count, bulge);
+        if (!identifiers_.empty()) identifiers_.push_back(0);
+    }
+
+    bool LwPolyline::load_vertex_tag(const int code, const String &value) {
+        if (code == 91) {
+            auto const id = utils::safe_str_to_int64(value);
+            if (x_.empty()) return id.has_value();
+            // The identifiers are stored only if present:
+            identifiers_.resize(x_.size(), 0);
+            identifiers_.back() = id.value_or(0);
+            return id.has_value();
+        }
+        auto const real = utils::safe_str_to_real(value);
+        Real const v = real.value_or(0.0);
+        if (code == 10) {
+            append(v, 0.0);
+        } else if (!x_.empty()) {  // ignore attributes in front of a vertex
+            switch (code) {
+                case 20:
+                    y_.back() = v;
+                    break;
+                case 40:
+                    set_optional(start_width_, x_.size(), v);
+                    break;
+                case 41:
+                    set_optional(end_width_, x_.size(), v);
+                    break;
+                case 42:
+                    set_optional(bulge_, x_.size(), v);
+                    break;
+                default:
+                    break;
+            }
+        }
+        return real.has_value();
+    }
+
+    void LwPolyline::load_vertices(tag::AscLoader &loader,
+                                   const std::size_t tags_index,
+                                   ErrorMessages &errors) {
+        vertex_tags_index_ = tags_index;
+        while (!loader.eof() &&
+               is_vertex_group_code(loader.peek().group_code())) {
+            auto const &tag = loader.peek();
+            if (!load_vertex_tag(tag.group_code(), tag.str()))
+                log_invalid_vertex_value(errors, loader.get_line_number());
+            loader.skip();
+        }
+    }
+
+    void LwPolyline::load_tags(tag::StringTags tags, ErrorMessages &errors,
+                               const std::size_t line_number) {
+        clear();
+        auto const first = std::find_if(
+                tags.begin(), tags.end(), [](const tag::StringTag &tag) {
+                    return tag.group_code() == 10;
+                });
+        for (auto it = tags.begin(); it != first; ++it) {
+            if (it->group_code() == 90) presize(it->str());
+        }
+        auto last = first;
+        for (; last != tags.end() && is_vertex_group_code(last->group_code());
+               ++last) {
+            if (!load_vertex_tag(last->group_code(), last->str()))
+                log_invalid_vertex_value(errors, line_number);
+        }
+        vertex_tags_index_ = first - tags.begin();
+        tags.erase(first, last);
+        set_raw_tags(std::move(tags));
+    }
+
+    void LwPolyline::for_each_vertex_tag(
+            const std::size_t index,
+            const std::function<void(const tag::StringTag &)> &fn) const {
+        fn(tag::StringTag(10, utils::real_to_str(x_[index])));
+        fn(tag::StringTag(20, utils::real_to_str(y_[index])));
+        auto const start_width = get_optional(start_width_, index);
+        auto const end_width = get_optional(end_width_, index);
+        auto const bulge = get_optional(bulge_, index);
+        if (start_width != 0.0 || end_width != 0.0) {
+            fn(tag::StringTag(40, utils::real_to_str(start_width)));
+            fn(tag::StringTag(41, utils::real_to_str(end_width)));
+        }
+        if (bulge != 0.0) fn(tag::StringTag(42, utils::real_to_str(bulge)));
+        if (!identifiers_.empty())
+            fn(tag::StringTag(91, std::to_string(identifiers_[index])));
+    }
+
+    void LwPolyline::for_each_tag(
+            const std::function<void(const tag::StringTag &)> &fn) const {
+        auto const &tags = get_raw_tags();
+        for (std::size_t index = 0; index <= tags.size(); ++index) {
+            if (index == vertex_tags_index_) {
+                for (std::size_t i = 0; i < size(); ++i)
+                    for_each_vertex_tag(i, fn);
+            }
+            if (index == tags.size()) break;
+            if (tags[index].group_code() == 90) {
+                fn(tag::StringTag(90, std::to_string(size())));
+            } else {
+                fn(tags[index]);
+            }
+        }
+    }
+
+    void LwPolyline::export_new_object_tags(tag::AscWriter &writer) const {
+        Entity::export_new_object_tags(writer);
+        writer.write(100, "AcDbPolyline");
+        writer.write_integer(90, static_cast<int64_t>(size()));
+        writer.write_integer(70, 0);
+    }
+
+    void LwPolyline::export_raw_tag(tag::AscWriter &writer,
+                                    const tag::StringTag &tag) const {
+        if (tag.group_code() == 90) {
+            writer.write_integer(90, static_cast<int64_t>(size()));
+        } else {
+            Entity::export_raw_tag(writer, tag);
+        }
+    }
+
+    void LwPolyline::export_decoded_tags(tag::AscWriter &writer,
+                                         const std::size_t index) const {
+        if (index != vertex_tags_index_) return;
+        for (std::size_t i = 0; i < size(); ++i) {
+            for_each_vertex_tag(i, [&writer](const tag::StringTag &tag) {
+                writer.write(tag);
+            });
+        }
+    }
+}
@@ -0,0 +1,236 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include "ezdxf/acdb/mesh.hpp"
+#include "ezdxf/tag/writer.hpp"
+#include "ezdxf/utils.hpp"
+
+namespace ezdxf::acdb {
+    // Group code of the count tag and the values of each data block:
+    const std::array<int, Mesh::kBlockCount> kCountCodes = {92, 93, 94, 95};
+    const std::array<int, Mesh::kBlockCount> kValueCodes = {10, 90, 90, 140};
+    // Count of value tags for each counted item:
+    const std::array<std::size_t, Mesh::kBlockCount> kTagsPerItem = {
+            3, 1, 2, 1};
+
+    static void log_invalid_value(ErrorMessages &errors, ErrorCode code,
+                                  std::size_t line_number) {
+        std::ostringstream msg;
+        msg << "Invalid MESH value in line " << line_number;
+        errors.emplace_back(code, msg.str());
+    }
+
+    class LoaderSource {
+        // Tag source of the bulk loader, reads the tags of the loader
+        // without copying.
+    private:
+        tag::AscLoader &loader_;
+
+    public:
+        explicit LoaderSource(tag::AscLoader &loader) : loader_(loader) {}
+
+        [[nodiscard]] bool eof() const { return loader_.eof(); }
+
+        [[nodiscard]] const tag::StringTag &peek() const {
+            return loader_.peek();
+        }
+
+        void next() { loader_.skip(); }
+
+        [[nodiscard]] std::size_t line_number() const {
+            return loader_.get_line_number();
+        }
+    };
+
+    class TagsSource {
+        // Tag source of already loaded tags.
+    private:
+        const tag::StringTags &tags_;
+        std::size_t index_{0};
+        std::size_t line_number_;
+
+    public:
+        TagsSource(const tag::StringTags &tags, std::size_t line_number) :
+                tags_(tags), line_number_(line_number) {}
+
+        [[nodiscard]] bool eof() const { return index_ >= tags_.size(); }
+
+        [[nodiscard]] const tag::StringTag &peek() const {
+            return tags_[index_];
+        }
+
+        void next() { ++index_; }
+
+        [[nodiscard]] std::size_t line_number() const { return line_number_; }
+    };
+
+    bool Mesh::is_next_block(const int code) const {
+        return next_block_ < kBlockCount &&
+               code >= kCountCodes[next_block_] &&
+               code <= kCountCodes[kCreases];
+    }
+
+    template<typename Source>
+    void Mesh::decode_block(Source &source, ErrorMessages &errors) {
+        auto const block = static_cast<Block>(
+                source.peek().group_code() - kCountCodes[kVertices]);
+        auto count = utils::safe_str_to_int64(source.peek().str());
+        if (!count) {
+            log_invalid_value(errors, ErrorCode::kInvalidIntegerTag,
+                              source.line_number());
+        }
+        source.next();
+        next_block_ = block + 1;
+        // The indices are 32-bit values, the limit prevents an overflow:
+        auto const tag_count = static_cast<std::size_t>(std::clamp<int64_t>(
+                count.value_or(0), 0, INT32_MAX)) * kTagsPerItem[block];
+        // The count tags are not trustworthy:
+        auto const reserve = std::min(tag_count, kMaxPresize);
+        auto const value_code = kValueCodes[block];
+        for (std::size_t i = 0; i < tag_count && !source.eof(); ++i) {
+            auto const &tag = source.peek();
+            int const code = tag.group_code();
+            if (block == kVertices) {
+                if (code != 10 && code != 20 && code != 30) break;
+                auto value = utils::safe_str_to_real(tag.str());
+                if (!value) {
+                    log_invalid_value(errors, ErrorCode::kInvalidRealTag,
+                                      source.line_number());
+                }
+                if (vertices_.empty()) vertices_.reserve(reserve);
+                if (code == 10 || vertices_.empty()) {
+                    vertices_.insert(vertices_.end(), {0.0, 0.0, 0.0});
+                }
+                vertices_[vertices_.size() - 3 + (code / 10 - 1)] =
+                        value.value_or(0.0);
+            } else if (code != value_code) {
+                break;
+            } else if (block == kCreases) {
+                auto value = utils::safe_str_to_real(tag.str());
+                if (!value) {
+                    log_invalid_value(errors, ErrorCode::kInvalidRealTag,
+                                      source.line_number());
+                }
+                if (creases_.empty()) creases_.reserve(reserve);
+                creases_.push_back(value.value_or(0.0));
+            } else {
+                auto value = utils::safe_str_to_int64(tag.str());
+                if (!value) {
+                    log_invalid_value(errors, ErrorCode::kInvalidIntegerTag,
+                                      source.line_number());
+                }
+                auto &buffer = block == kFaces ? faces_ : edges_;
+                if (buffer.empty()) buffer.reserve(reserve);
+                buffer.push_back(static_cast<int32_t>(value.value_or(0)));
+            }
+            source.next();
+        }
+    }
+
+    void Mesh::append_vertex(Real x, Real y, Real z) {
+        vertices_.insert(vertices_.end(), {x, y, z});
+    }
+
+    void Mesh::append_face(Span<int32_t> indices) {
+        faces_.push_back(static_cast<int32_t>(indices.size()));
+        faces_.insert(faces_.end(), indices.begin(), indices.end());
+    }
+
+    void Mesh::load_block(tag::AscLoader &loader, const std::size_t tags_index,
+                          ErrorMessages &errors) {
+        auto const block = loader.peek().group_code() - kCountCodes[kVertices];
+        block_index_[block] = tags_index;
+        auto source = LoaderSource(loader);
+        decode_block(source, errors);
+    }
+
+    void Mesh::load_tags(tag::StringTags tags, ErrorMessages &errors,
+                         const std::size_t line_number) {
+        auto raw_tags = tag::StringTags{};
+        auto source = TagsSource(tags, line_number);
+        bool subclass = false;  // (100, AcDbSubDMesh) is loaded
+        while (!source.eof()) {
+            auto const &tag = source.peek();
+            if (subclass && is_next_block(tag.group_code())) {
+                block_index_[tag.group_code() - kCountCodes[kVertices]] =
+                        raw_tags.size();
+                decode_block(source, errors);
+                continue;
+            }
+            if (tag.equals(100, "AcDbSubDMesh")) subclass = true;
+            raw_tags.push_back(tag);
+            source.next();
+        }
+        set_raw_tags(std::move(raw_tags));
+    }
+
+    void Mesh::for_each_block_tag(
+            const Block block,
+            const std::function<void(const tag::StringTag &)> &fn) const {
+        auto const integer = [](int code, int64_t value) {
+            return tag::StringTag(code, std::to_string(value));
+        };
+        auto const real = [](int code, Real value) {
+            return tag::StringTag(code, utils::real_to_str(value));
+        };
+        switch (block) {
+            case kVertices:
+                fn(integer(92, static_cast<int64_t>(vertex_count())));
+                for (std::size_t i = 0; i + 2 < vertices_.size(); i += 3) {
+                    fn(real(10, vertices_[i]));
+                    fn(real(20, vertices_[i + 1]));
+                    fn(real(30, vertices_[i + 2]));
+                }
+                break;
+            case kFaces:
+                fn(integer(93, static_cast<int64_t>(faces_.size())));
+                for (auto const index : faces_) fn(integer(90, index));
+                break;
+            case kEdges:
+                fn(integer(94, static_cast<int64_t>(edges_.size() / 2)));
+                for (auto const index : edges_) fn(integer(90, index));
+                break;
+            case kCreases:
+                fn(integer(95, static_cast<int64_t>(creases_.size())));
+                for (auto const value : creases_) fn(real(140, value));
+                break;
+            default:
+                break;
+        }
+    }
+
+    void Mesh::for_each_tag(
+            const std::function<void(const tag::StringTag &)> &fn) const {
+        auto const &tags = get_raw_tags();
+        for (std::size_t index = 0; index <= tags.size(); ++index) {
+            for (int block = 0; block < kBlockCount; ++block) {
+                if (block_index_[block] == index)
+                    for_each_block_tag(static_cast<Block>(block), fn);
+            }
+            if (index < tags.size()) fn(tags[index]);
+        }
+    }
+
+    void Mesh::export_new_object_tags(tag::AscWriter &writer) const {
+        Entity::export_new_object_tags(writer);
+        writer.write(100, "AcDbSubDMesh");
+        writer.write_integer(71, 2);  // version
+        writer.write_integer(72, 0);  // blend crease
+        writer.write_integer(91, 0);  // subdivision level
+    }
+
+    void Mesh::export_decoded_tags(tag::AscWriter &writer,
+                                   const std::size_t index) const {
+        for (int block = 0; block < kBlockCount; ++block) {
+            auto const position = is_loaded() ? block_index_[block] : 0;
+            if (position != index) continue;
+            for_each_block_tag(static_cast<Block>(block),
+                               [&writer](const tag::StringTag &tag) {
+                                   writer.write(tag);
+                               });
+        }
+    }
+}
@@ -0,0 +1,404 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include "ezdxf/acdb/polyline.hpp"
+#include "ezdxf/tag/writer.hpp"
+#include "ezdxf/utils.hpp"
+
+namespace ezdxf::acdb {
+    // POLYLINE flags (70):
+    const int32_t kPolygonMesh = 16;
+    const int32_t kPolyfaceMesh = 64;
+
+    // VERTEX flags (70):
+    const int32_t kVertex3dPolyline = 32;
+    const int32_t kVertexPolygonMesh = 64;
+    const int32_t kVertexPolyfaceMesh = 128;
+
+    static bool is_face_record(const int32_t flags) {
+        // Face records of polyface meshes are VERTEX entities without
+        // coordinates:
+        return (flags & kVertexPolyfaceMesh) && !(flags & kVertexPolygonMesh);
+    }
+
+    static const char *vertex_subclass(const int32_t flags) {
+        if (flags & kVertexPolyfaceMesh) return "AcDbPolyFaceMeshVertex";
+        if (flags & kVertexPolygonMesh) return "AcDbPolygonMeshVertex";
+        if (flags & kVertex3dPolyline) return "AcDb3dPolylineVertex";
+        return "AcDb2dVertex";
+    }
+
+    static void log_invalid_value(ErrorMessages &errors, int code,
+                                  std::size_t line_number) {
+        std::ostringstream msg;
+        msg << "Invalid VERTEX or SEQEND value in line " << line_number;
+        auto error = ErrorCode::kInvalidRealTag;
+        if (code == 5 || is_pointer_group_code(code)) {
+            error = ErrorCode::kInvalidHandle;
+        } else if (code >= 70) {
+            error = ErrorCode::kInvalidIntegerTag;
+        }
+        errors.emplace_back(error, msg.str());
+    }
+
+    class SequenceDecoder {
+        // Decodes the tags of the VERTEX and SEQEND entities of a POLYLINE.
+    private:
+        Polyline &polyline_;
+        ErrorMessages &errors_;
+        bool references_;  // add pointer references to the POLYLINE
+        bool seqend_ = false;
+        std::size_t count_ = 0;  // count of decoded entities
+        bool first_ = false;  // decoding the first entity of the sequence
+        bool has_owner_ = false;
+        bool app_data_ = false;
+
+        [[nodiscard]] bool decode_reference(const tag::StringTag &tag) {
+            // Returns false for invalid handles of pointer references:
+            int const code = tag.group_code();
+            if (!is_pointer_group_code(code)) return true;
+            auto const handle = utils::safe_str_to_handle(tag.str());
+            if (!handle) return false;
+            if (references_) polyline_.add_reference(code, handle.value());
+            return true;
+        }
+
+        [[nodiscard]] bool add_extra_tag(const tag::StringTag &tag) {
+            if (seqend_) {
+                polyline_.seqend_extra_tags_.push_back(tag);
+            } else {
+                polyline_.extra_tags_.push_back(
+                        Polyline::ExtraTag{polyline_.size() - 1, tag});
+            }
+            return decode_reference(tag);
+        }
+
+        [[nodiscard]] bool add_app_data(const tag::StringTag &tag) {
+            if (seqend_) {
+                polyline_.seqend_app_data_.push_back(tag);
+            } else {
+                polyline_.app_data_.push_back(
+                        Polyline::ExtraTag{polyline_.size() - 1, tag});
+            }
+            return decode_reference(tag);
+        }
+
+        bool decode_structure_tag(int code, const tag::StringTag &tag) {
+            // Decodes the tags of the AcDbEntity subclass, which are shared
+            // by the VERTEX and the SEQEND entity:
+            if (code == 102) {
+                // Application defined data: (102, "{NAME") ... (102, "}")
+                auto const &value = tag.str();
+                app_data_ = !value.empty() && value[0] == '{';
+                return add_app_data(tag);
+            }
+            if (app_data_) return add_app_data(tag);
+            if (code == 5) {
+                auto handle = utils::safe_str_to_handle(tag.str());
+                if (!handle) return false;
+                if (seqend_)
+                    polyline_.seqend_handle_ = handle.value();
+                else
+                    polyline_.vertex_handles_.back() = handle.value();
+            } else if (code == 330 && !has_owner_) {
+                // The owner is always the POLYLINE entity:
+                has_owner_ = true;
+                if (first_) polyline_.owner_tags_ = true;
+            } else if (code == 100) {
+                if (first_) polyline_.subclass_markers_ = true;
+            } else if (code == 8) {
+                auto const &layer = tag.str();
+                if (seqend_) {
+                    if (layer != polyline_.get_layer())
+                        polyline_.seqend_layer_ = layer;
+                } else if (first_ && layer != polyline_.get_layer()) {
+                    polyline_.vertex_layer_ = layer;
+                } else if (layer != (polyline_.vertex_layer_.empty()
+                                     ? polyline_.get_layer()
+                                     : polyline_.vertex_layer_)) {
+                    return add_extra_tag(tag);
+                }
+            } else {
+                return add_extra_tag(tag);
+            }
+            return true;
+        }
+
+        bool decode_vertex_tag(int code, const tag::StringTag &tag) {
+            if (app_data_ || code < 10 || code > 74 ||
+                (code > 42 && code < 70) || (code > 30 && code < 40))
+                return decode_structure_tag(code, tag);
+            if (code >= 70) {
+                auto const value = utils::safe_str_to_int64(tag.str());
+                auto const v = static_cast<int32_t>(value.value_or(0));
+                if (code == 70) {
+                    polyline_.flags_.back() = v;
+                } else {
+                    auto &indices = polyline_.face_indices_;
+                    indices.resize(polyline_.size() * 4, 0);
+                    indices[(polyline_.size() - 1) * 4 + (code - 71)] = v;
+                }
+                return value.has_value();
+            }
+            auto const value = utils::safe_str_to_real(tag.str());
+            auto const v = value.value_or(0.0);
+            switch (code) {
+                case 10:
+                    polyline_.x_.back() = v;
+                    break;
+                case 20:
+                    polyline_.y_.back() = v;
+                    break;
+                case 30:
+                    polyline_.z_.back() = v;
+                    break;
+                case 40:
+                    polyline_.start_width_.back() = v;
+                    break;
+                case 41:
+                    polyline_.end_width_.back() = v;
+                    break;
+                case 42:
+                    polyline_.bulge_.back() = v;
+                    break;
+                default:
+                    return decode_structure_tag(code, tag);
+            }
+            return value.has_value();
+        }
+
+    public:
+        SequenceDecoder(Polyline &polyline, ErrorMessages &errors,
+                        bool references) :
+                polyline_(polyline), errors_(errors),
+                references_(references) {
+            polyline_.owner_tags_ = false;
+            polyline_.subclass_markers_ = false;
+        }
+
+        [[nodiscard]] bool is_finished() const { return seqend_; }
+
+        bool begin(const tag::StringTag &structure_tag) {
+            // Starts a new VERTEX or SEQEND entity, returns false for
+            // all other structure tags, which end the sequence.
+            if (seqend_) return false;
+            if (structure_tag.str() == "VERTEX") {
+                polyline_.append(0, 0.0, 0.0);
+            } else if (structure_tag.str() == "SEQEND") {
+                seqend_ = true;
+                polyline_.has_seqend_ = true;
+            } else {
+                return false;
+            }
+            first_ = count_++ == 0;
+            has_owner_ = false;
+            app_data_ = false;
+            return true;
+        }
+
+        void decode(const tag::StringTag &tag, std::size_t line_number) {
+            int code = tag.group_code();
+            bool ok = seqend_ ? decode_structure_tag(code, tag)
+                              : decode_vertex_tag(code, tag);
+            if (!ok) log_invalid_value(errors_, code, line_number);
+        }
+    };
+
+    Handle Polyline::max_sequence_handle() const {
+        Handle handle = seqend_handle_;
+        for (auto const h : vertex_handles_) handle = std::max(handle, h);
+        return handle;
+    }
+
+    std::vector<Handle> Polyline::sequence_handles() const {
+        auto handles = std::vector<Handle>{};
+        handles.reserve(vertex_handles_.size() + 1);
+        for (auto const h : vertex_handles_) {
+            if (h) handles.push_back(h);
+        }
+        if (seqend_handle_) handles.push_back(seqend_handle_);
+        return handles;
+    }
+
+    void Polyline::reserve(const std::size_t count) {
+        x_.reserve(count);
+        y_.reserve(count);
+        z_.reserve(count);
+        start_width_.reserve(count);
+        end_width_.reserve(count);
+        bulge_.reserve(count);
+        flags_.reserve(count);
+        vertex_handles_.reserve(count);
+    }
+
+    void Polyline::append(Handle handle, Real x, Real y, Real z,
+                          int32_t flags) {
+        x_.push_back(x);
+        y_.push_back(y);
+        z_.push_back(z);
+        start_width_.push_back(0.0);
+        end_width_.push_back(0.0);
+        bulge_.push_back(0.0);
+        flags_.push_back(flags);
+        vertex_handles_.push_back(handle);
+        if (!face_indices_.empty()) face_indices_.resize(size() * 4, 0);
+    }
+
+    static std::size_t vertex_count_hint(const Polyline &polyline) {
+        // Count of vertices of polygon and polyface meshes by the
+        // POLYLINE tags, 0 for unknown:
+        auto value = [&polyline](int code) -> int64_t {
+            auto const tag = polyline.find_raw_tag(code);
+            if (!tag) return 0;
+            return std::max<int64_t>(
+                    0, utils::safe_str_to_int64(tag->str()).value_or(0));
+        };
+        auto const flags = value(70);
+        int64_t count = 0;
+        if (flags & kPolygonMesh) {
+            count = value(71) * value(72);  // M x N vertices
+        } else if (flags & kPolyfaceMesh) {
+            count = value(71) + value(72);  // vertices + face records
+        }
+        return std::min(static_cast<std::size_t>(std::max<int64_t>(0, count)),
+                        kMaxPresize);
+    }
+
+    void Polyline::load_sequence(tag::AscLoader &loader,
+                                 ErrorMessages &errors) {
+        reserve(vertex_count_hint(*this));
+        auto decoder = SequenceDecoder(*this, errors, true);
+        while (!loader.eof() && !decoder.is_finished() &&
+               decoder.begin(loader.peek())) {
+            loader.skip();  // structure tag
+            while (!loader.eof() &&
+                   loader.peek().group_code() != tag::GroupCode::kStructure) {
+                decoder.decode(loader.peek(), loader.get_line_number());
+                loader.skip();
+            }
+        }
+    }
+
+    void Polyline::load_tags(tag::StringTags tags, ErrorMessages &errors,
+                             const std::size_t line_number) {
+        auto const first = std::find_if(
+                tags.begin(), tags.end(), [](const tag::StringTag &tag) {
+                    return tag.group_code() == tag::GroupCode::kStructure;
+                });
+        auto sequence = tag::StringTags(std::make_move_iterator(first),
+                                        std::make_move_iterator(tags.end()));
+        tags.erase(first, tags.end());
+        set_raw_tags(std::move(tags));
+        reserve(vertex_count_hint(*this));
+        auto decoder = SequenceDecoder(*this, errors, false);
+        bool active = false;
+        for (auto const &tag : sequence) {
+            if (tag.group_code() == tag::GroupCode::kStructure) {
+                active = decoder.begin(tag);
+                if (!active) break;
+            } else if (active) {
+                decoder.decode(tag, line_number);
+            }
+        }
+    }
+
+    void Polyline::for_each_sequence_tag(
+            const std::function<void(const tag::StringTag &)> &fn) const {
+        auto const handle = utils::handle_to_str(get_handle());
+        auto const &vertex_layer =
+                vertex_layer_.empty() ? get_layer() : vertex_layer_;
+        auto const real = [](int code, Real value) {
+            return tag::StringTag(code, utils::real_to_str(value));
+        };
+        auto const integer = [](int code, int64_t value) {
+            return tag::StringTag(code, std::to_string(value));
+        };
+        auto extra = extra_tags_.begin();
+        auto app_data = app_data_.begin();
+        for (std::size_t i = 0; i < size(); ++i) {
+            auto const first_extra = extra;
+            auto layer = extra_tags_.end();  // different layer of the vertex
+            while (extra != extra_tags_.end() && extra->vertex == i) {
+                if (extra->tag.group_code() == 8) layer = extra;
+                ++extra;
+            }
+            fn(tag::StringTag(0, "VERTEX"));
+            if (vertex_handles_[i])
+                fn(tag::StringTag(5, utils::handle_to_str(vertex_handles_[i])));
+            for (; app_data != app_data_.end() && app_data->vertex == i;
+                   ++app_data)
+                fn(app_data->tag);
+            if (owner_tags_) fn(tag::StringTag(330, handle));
+            if (subclass_markers_) fn(tag::StringTag(100, "AcDbEntity"));
+            if (layer == extra_tags_.end()) {
+                fn(tag::StringTag(8, vertex_layer));
+            } else {
+                fn(layer->tag);
+            }
+            auto const flags = flags_[i];
+            if (subclass_markers_) {
+                if (is_face_record(flags)) {
+                    fn(tag::StringTag(100, "AcDbFaceRecord"));
+                } else {
+                    fn(tag::StringTag(100, "AcDbVertex"));
+                    fn(tag::StringTag(100, vertex_subclass(flags)));
+                }
+            }
+            fn(real(10, x_[i]));
+            fn(real(20, y_[i]));
+            fn(real(30, z_[i]));
+            if (start_width_[i] != 0.0 || end_width_[i] != 0.0) {
+                fn(real(40, start_width_[i]));
+                fn(real(41, end_width_[i]));
+            }
+            if (bulge_[i] != 0.0) fn(real(42, bulge_[i]));
+            fn(integer(70, flags));
+            if (!face_indices_.empty()) {
+                for (int j = 0; j < 4; ++j) {
+                    auto const index = face_indices_[i * 4 + j];
+                    if (index) fn(integer(71 + j, index));
+                }
+            }
+            for (auto it = first_extra; it != extra; ++it) {
+                if (it != layer) fn(it->tag);
+            }
+        }
+        if (!has_seqend_) return;
+        fn(tag::StringTag(0, "SEQEND"));
+        if (seqend_handle_)
+            fn(tag::StringTag(5, utils::handle_to_str(seqend_handle_)));
+        for (auto const &tag : seqend_app_data_) fn(tag);
+        if (owner_tags_) fn(tag::StringTag(330, handle));
+        if (subclass_markers_) fn(tag::StringTag(100, "AcDbEntity"));
+        fn(tag::StringTag(8, seqend_layer_.empty() ? get_layer()
+                                                   : seqend_layer_));
+        for (auto const &tag : seqend_extra_tags_) fn(tag);
+    }
+
+    void Polyline::for_each_tag(
+            const std::function<void(const tag::StringTag &)> &fn) const {
+        Entity::for_each_tag(fn);
+        for_each_sequence_tag(fn);
+    }
+
+    void Polyline::export_new_object_tags(tag::AscWriter &writer) const {
+        Entity::export_new_object_tags(writer);
+        writer.write(100, "AcDb2dPolyline");
+        writer.write_integer(66, 1);
+        writer.write_real(10, 0.0);
+        writer.write_real(20, 0.0);
+        writer.write_real(30, 0.0);
+        writer.write_integer(70, 0);
+    }
+
+    void Polyline::export_decoded_tags(tag::AscWriter &writer,
+                                       const std::size_t index) const {
+        if (index != get_raw_tags().size()) return;
+        for_each_sequence_tag([&writer](const tag::StringTag &tag) {
+            writer.write(tag);
+        });
+    }
+}
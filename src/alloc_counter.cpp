@@ -0,0 +1,165 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "ezdxf/alloc_counter.hpp"
+
+namespace ezdxf::alloc {
+    static std::atomic<unsigned int> active_counters{0};
+    static std::atomic<std::size_t> allocations{0};
+    static std::atomic<std::size_t> deallocations{0};
+    static std::atomic<std::size_t> allocated_bytes{0};
+
+    static AllocationStats current() {
+        return AllocationStats{allocations.load(), deallocations.load(),
+                               allocated_bytes.load()};
+    }
+
+    AllocationCounter::AllocationCounter() {
+        ++active_counters;
+        start_ = current();
+    }
+
+    AllocationCounter::~AllocationCounter() {
+        --active_counters;
+    }
+
+    AllocationStats AllocationCounter::stats() const {
+        auto const now = current();
+        return AllocationStats{now.allocations - start_.allocations,
+                               now.deallocations - start_.deallocations,
+                               now.bytes - start_.bytes};
+    }
+
+    static void count_allocation(std::size_t size) {
+        if (active_counters.load(std::memory_order_relaxed)) {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+            allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+    }
+
+    static void count_deallocation(void *ptr) {
+        if (ptr && active_counters.load(std::memory_order_relaxed))
+            deallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void *allocate(std::size_t size) noexcept {
+        count_allocation(size);
+        // malloc(0) may return nullptr, operator new(0) must not:
+        return std::malloc(size ? size : 1);
+    }
+
+    static void *allocate(std::size_t size, std::align_val_t align) noexcept {
+        count_allocation(size);
+        auto const alignment = static_cast<std::size_t>(align);
+        // The size has to be a multiple of the alignment:
+        size = (size + alignment - 1) / alignment * alignment;
+#if defined(_WIN32)
+        return _aligned_malloc(size ? size : alignment, alignment);
+#else
+        return std::aligned_alloc(alignment, size ? size : alignment);
+#endif
+    }
+
+    static void deallocate(void *ptr) noexcept {
+        count_deallocation(ptr);
+        std::free(ptr);
+    }
+
+    static void deallocate(void *ptr, std::align_val_t) noexcept {
+        count_deallocation(ptr);
+#if defined(_WIN32)
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    template<typename... Args>
+    static void *allocate_or_throw(std::size_t size, Args... args) {
+        void *ptr = allocate(size, args...);
+        if (!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+}
+
+// Replacements of the global allocation functions:
+
+using ezdxf::alloc::allocate;
+using ezdxf::alloc::allocate_or_throw;
+using ezdxf::alloc::deallocate;
+
+void *operator new(std::size_t size) { return allocate_or_throw(size); }
+
+void *operator new[](std::size_t size) { return allocate_or_throw(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+    return allocate_or_throw(size, align);
+}
+
+void *operator new[](std::size_t size, std::align_val_t align) {
+    return allocate_or_throw(size, align);
+}
+
+void *operator new(std::size_t size, std::align_val_t align,
+                   const std::nothrow_t &) noexcept {
+    return allocate(size, align);
+}
+
+void *operator new[](std::size_t size, std::align_val_t align,
+                     const std::nothrow_t &) noexcept {
+    return allocate(size, align);
+}
+
+void operator delete(void *ptr) noexcept { deallocate(ptr); }
+
+void operator delete[](void *ptr) noexcept { deallocate(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { deallocate(ptr); }
+
+void operator delete[](void *ptr, std::size_t) noexcept { deallocate(ptr); }
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t align) noexcept {
+    deallocate(ptr, align);
+}
+
+void operator delete[](void *ptr, std::align_val_t align) noexcept {
+    deallocate(ptr, align);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t align) noexcept {
+    deallocate(ptr, align);
+}
+
+void operator delete[](void *ptr, std::size_t,
+                       std::align_val_t align) noexcept {
+    deallocate(ptr, align);
+}
+
+void operator delete(void *ptr, std::align_val_t align,
+                     const std::nothrow_t &) noexcept {
+    deallocate(ptr, align);
+}
+
+void operator delete[](void *ptr, std::align_val_t align,
+                       const std::nothrow_t &) noexcept {
+    deallocate(ptr, align);
+}
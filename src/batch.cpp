@@ -0,0 +1,163 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include "ezdxf/batch.hpp"
+#include "ezdxf/trace.hpp"
+
+namespace ezdxf {
+    struct BatchLoader::State {
+        std::vector<std::string> filenames{};  // biggest files first
+        LoadOptions options{};
+        std::atomic<std::size_t> next_file{0};
+        std::atomic<bool> cancelled{false};
+        std::mutex mutex{};
+        std::condition_variable finished_cv{};
+        std::deque<BatchResult> finished{};  // guarded by mutex
+        std::size_t returned{0};  // count of results returned by next()
+    };
+
+    static std::vector<std::string>
+    sort_by_file_size(const std::vector<std::string> &filenames) {
+        // Returns the filenames in order of descending file size, not
+        // existing files are located at the end.
+        auto sizes = std::vector<std::pair<std::uintmax_t, std::string>>{};
+        sizes.reserve(filenames.size());
+        for (auto const &filename : filenames) {
+            std::error_code ec;
+            auto size = std::filesystem::file_size(filename, ec);
+            sizes.emplace_back(ec ? 0 : size, filename);
+        }
+        std::stable_sort(sizes.begin(), sizes.end(),
+                         [](auto const &a, auto const &b) {
+                             return a.first > b.first;
+                         });
+        auto result = std::vector<std::string>{};
+        result.reserve(sizes.size());
+        for (auto &item : sizes) result.push_back(std::move(item.second));
+        return result;
+    }
+
+    static BatchResult load_file(const std::string &filename,
+                                 const LoadOptions &options) {
+        // The read buffer of the file stream is reused by all files loaded
+        // by the same worker thread. A worker can load a nested file while
+        // waiting for parallel tasks of the outer file, the nested file uses
+        // the default buffer of the file stream:
+        static thread_local auto buffer =
+                std::vector<char>(kBatchReadBufferSize);
+        static thread_local bool buffer_in_use = false;
+        struct BufferLock {
+            bool locked = !buffer_in_use;
+
+            BufferLock() { buffer_in_use = true; }
+
+            ~BufferLock() { if (locked) buffer_in_use = false; }
+        } buffer_lock{};
+
+        auto const span = trace::Span("load file", filename);
+        auto result = BatchResult{filename};
+        try {
+            auto stream = std::ifstream{};
+            // The buffer has to be set before opening the file:
+            if (buffer_lock.locked) {
+                stream.rdbuf()->pubsetbuf(buffer.data(),
+                                          static_cast<std::streamsize>(
+                                                  buffer.size()));
+            }
+            stream.open(filename, std::ios::binary);
+            if (!stream) {
+                result.error = "Cannot open file";
+                return result;
+            }
+            auto string_tags = tag::BasicLoader(stream);
+            auto tags = tag::AscLoader(string_tags);
+            if (result.document.load(tags, options)) {
+                result.document.filename = filename;
+            } else {
+                result.document = Document();
+                result.error = "Premature end of DXF data";
+            }
+        } catch (const std::exception &e) {
+            result.document = Document();
+            result.error = e.what();
+        }
+        return result;
+    }
+
+    BatchLoader::BatchLoader(const std::vector<std::string> &filenames,
+                             const LoadOptions &options, ThreadPool &pool) :
+            pool_(pool), state_(std::make_shared<State>()) {
+        state_->filenames = sort_by_file_size(filenames);
+        state_->options = options;
+        // Each task loads the next file of the shared file list and not a
+        // fixed file, so the biggest files are started first, regardless of
+        // the task order of the pool:
+        for (std::size_t i = 0; i < state_->filenames.size(); ++i) {
+            pool_.submit([state = state_]() {
+                std::size_t index = state->next_file++;
+                auto result = state->cancelled
+                              ? BatchResult{state->filenames[index],
+                                            Document(), "Cancelled"}
+                              : load_file(state->filenames[index],
+                                          state->options);
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->finished.push_back(std::move(result));
+                }
+                state->finished_cv.notify_all();
+            });
+        }
+    }
+
+    BatchLoader::~BatchLoader() {
+        state_->cancelled = true;
+    }
+
+    std::size_t BatchLoader::size() const {
+        return state_->filenames.size();
+    }
+
+    std::optional<BatchResult> BatchLoader::next() {
+        auto &state = *state_;
+        std::unique_lock<std::mutex> lock(state.mutex);
+        while (true) {
+            if (!state.finished.empty()) {
+                auto result = std::move(state.finished.front());
+                state.finished.pop_front();
+                ++state.returned;
+                return result;
+            }
+            if (state.returned == state.filenames.size()) return {};
+            // Help processing tasks, which prevents a deadlock if next() is
+            // called by a worker thread of the pool:
+            lock.unlock();
+            bool processed = pool_.run_pending_task();
+            lock.lock();
+            if (!processed) {
+                // All remaining files are loaded by other threads:
+                state.finished_cv.wait(lock, [&state]() {
+                    return !state.finished.empty();
+                });
+            }
+        }
+    }
+
+    std::vector<BatchResult> readfiles(const std::vector<std::string> &filenames,
+                                       const LoadOptions &options) {
+        auto loader = BatchLoader(filenames, options);
+        auto results = std::vector<BatchResult>{};
+        results.reserve(loader.size());
+        while (auto result = loader.next()) {
+            results.push_back(std::move(*result));
+        }
+        return results;
+    }
+}
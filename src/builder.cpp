@@ -0,0 +1,28 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <stdexcept>
+#include "ezdxf/builder.hpp"
+#include "ezdxf/ezdxf.hpp"
+
+namespace ezdxf {
+
+    EntityBuilder::EntityBuilder(Document &doc, Handle block_size) :
+            doc_(&doc), block_size_(block_size) {
+        if (block_size_ == 0)
+            throw std::invalid_argument("handle block size 0 is invalid");
+        next_handle_ = doc_->reserve_handles(block_size_);
+        end_handle_ = next_handle_ + block_size_;
+    }
+
+    Object *EntityBuilder::add(std::unique_ptr<Object> object) {
+        if (object->get_handle() == 0) {
+            if (next_handle_ == end_handle_) {
+                next_handle_ = doc_->reserve_handles(block_size_);
+                end_handle_ = next_handle_ + block_size_;
+            }
+            object->set_handle(next_handle_++);
+        }
+        return objects_.emplace_back(std::move(object)).get();
+    }
+}
@@ -1,22 +1,1080 @@
 // Copyright (c) 2020, Manfred Moitzi
 // License: MIT License
 //
-
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <thread>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
 #include "ezdxf/ezdxf.hpp"
+#include "ezdxf/binary_stream.hpp"
+#include "ezdxf/handle_order.hpp"
+#include "ezdxf/resolver.hpp"
+#include "ezdxf/trace.hpp"
+#include "ezdxf/tag/writer.hpp"
+#include "ezdxf/acdb/entity.hpp"
+#include "ezdxf/acdb/factory.hpp"
+#include "ezdxf/acdb/polyline.hpp"
+#include "ezdxf/utils.hpp"
+
+namespace ezdxf {
+
+    static bool is_object_section(const String &name) {
+        return name == "TABLES" || name == "BLOCKS" ||
+               name == "ENTITIES" || name == "OBJECTS";
+    }
+
+    static bool is_sorted_section(const String &name) {
+        // The TABLES and BLOCKS sections are never sorted, see export_dxf():
+        return name == "ENTITIES" || name == "OBJECTS";
+    }
+
+    static bool is_model_space_name(String name) {
+        // Block names are case insensitive:
+        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+        return name == "*MODEL_SPACE";
+    }
+
+    class EntityFilter {
+        // Filter of selective loading, see LoadOptions.
+    private:
+        std::array<bool, kDXFTypeCount> types_{};
+        std::vector<String> layers_{};  // uppercase
+
+    public:
+        explicit EntityFilter(const LoadOptions &options) {
+            types_.fill(options.types.empty());
+            for (auto const type : options.types)
+                types_[static_cast<std::size_t>(type)] = true;
+            for (auto layer : options.layers) {
+                std::transform(layer.begin(), layer.end(), layer.begin(),
+                               ::toupper);
+                layers_.push_back(std::move(layer));
+            }
+        }
+
+        [[nodiscard]] bool accepts_type(DXFType type) const {
+            return type == DXFType::None ||
+                   types_[static_cast<std::size_t>(type)];
+        }
+
+        [[nodiscard]] bool filters_layers() const { return !layers_.empty(); }
+
+        [[nodiscard]] bool accepts_layer(String layer) const {
+            std::transform(layer.begin(), layer.end(), layer.begin(),
+                           ::toupper);
+            return layers_.empty() ||
+                   std::find(layers_.begin(), layers_.end(), layer) !=
+                   layers_.end();
+        }
+    };
+
+    class LoadMonitor {
+        // Reports the loading progress, checks the cancellation token,
+        // see LoadOptions, and counts the loaded DXF objects.
+    private:
+        const LoadOptions &options_;
+        LoadStats &stats_;
+        LoadProgress progress_{};
+        std::size_t next_report_;
+        bool cancelled_{false};
+
+    public:
+        LoadMonitor(const LoadOptions &options, LoadStats &stats) :
+                options_(options), stats_(stats),
+                next_report_(std::max<std::size_t>(
+                        1, options.progress_interval)) {}
+
+        void count_object(DXFType type) {
+            ++stats_.objects;
+            if (type == DXFType::None) return;
+            ++stats_.entities[static_cast<std::size_t>(type)];
+            ++progress_.entities;
+        }
+
+        [[nodiscard]] const LoadOptions &options() const { return options_; }
+
+        [[nodiscard]] bool is_cancelled() const { return cancelled_; }
+
+        bool poll(const tag::AscLoader &loader) {
+            // Returns true if loading is cancelled, reports the progress
+            // after each progress interval.
+            if (options_.progress && loader.get_offset() >= next_report_) {
+                report(loader);
+                next_report_ = progress_.bytes +
+                               std::max<std::size_t>(
+                                       1, options_.progress_interval);
+            }
+            if (!cancelled_) cancelled_ = options_.cancellation.is_cancelled();
+            return cancelled_;
+        }
+
+        void report(const tag::AscLoader &loader) {
+            if (!options_.progress) return;
+            progress_.bytes = loader.get_offset();
+            progress_.line_number = loader.get_line_number();
+            options_.progress(progress_);
+        }
+    };
+
+    Document readfile(const std::string &filename,
+                      const LoadOptions &options) {
+        auto doc = Document();
+        auto stream = std::ifstream(filename, std::ios::binary);
+        if (!stream) return doc;
+        auto string_tags = ezdxf::tag::BasicLoader(stream);
+        auto tags = ezdxf::tag::AscLoader(string_tags);
+        if (doc.load(tags, options)) {
+            doc.filename = filename;
+            return doc;
+        } else {
+            return ezdxf::Document();
+        }
+    }
+
+    Document readfile_lazy(const std::string &filename) {
+        auto doc = Document();
+        auto stream = std::make_unique<std::ifstream>(filename,
+                                                      std::ios::binary);
+        if (!*stream) return doc;
+        if (doc.load_lazy(std::move(stream))) {
+            doc.filename = filename;
+            return doc;
+        } else {
+            return ezdxf::Document();
+        }
+    }
 
+    bool Document::load(tag::AscLoader &loader, const LoadOptions &options) {
+        // Returns true if the DXF structure was loaded until the final
+        // (0, EOF) tag, returns false for a premature end of the DXF data,
+        // but all valid data is loaded anyway.
+        auto const load_span = trace::Span("load");
+        auto parse_span = std::optional<trace::Span>();
+        parse_span.emplace("parse");
+        prepare_change();
+        using Clock = std::chrono::steady_clock;
+        auto start = Clock::now();
+        auto const start_error_count = errors_.size();
+        load_stats_ = LoadStats{};
+        auto const filter = EntityFilter(options);
+        if (options.columnar_geometry && !geometry_)
+            geometry_ = std::make_unique<GeometryStore>();
+        auto monitor = LoadMonitor(options, load_stats_);
+        bool eof = false;
+        while (!loader.eof() && !monitor.poll(loader)) {
+            auto const &tag = loader.peek();
+            if (tag.equals(0, "SECTION")) {
+                load_section(loader, filter, monitor);
+            } else if (tag.equals(0, "EOF")) {
+                eof = true;
+                break;
+            } else {
+                log_structure_error("Unexpected tag outside of a section",
+                                    loader.get_line_number());
+                loader.get();  // skip tag
+            }
+        }
+        if (monitor.is_cancelled()) {
+            std::ostringstream msg;
+            msg << "Loading cancelled in line " << loader.get_line_number();
+            errors_.emplace_back(ErrorCode::kLoadingCancelled, msg.str());
+            eof = false;
+        }
+        // The loaded objects are valid DXF objects, the document is
+        // completed also for cancelled and incomplete loading:
+        auto const elapsed = [&start]() {
+            // Returns the seconds since the start of the previous phase:
+            auto const now = Clock::now();
+            auto const seconds =
+                    std::chrono::duration<double>(now - start).count();
+            start = now;
+            return seconds;
+        };
+        load_stats_.seconds[static_cast<std::size_t>(LoadPhase::kParse)] =
+                elapsed();
+        parse_span.reset();
+        std::sort(skipped_.begin(), skipped_.end());
+        assign_missing_handles();
+        load_stats_.seconds[static_cast<std::size_t>(
+                LoadPhase::kAssignHandles)] = elapsed();
+        build_indices(&load_stats_);
 
-ezdxf::Document readfile(const std::string &filename) {
-    auto doc = ezdxf::Document();
-    auto string_tags = ezdxf::tag::BasicLoader(filename);
-    auto tags = ezdxf::tag::AscLoader(string_tags);
-    if (doc.load(tags)) {
-        doc.filename = filename;
+        load_stats_.bytes = loader.get_offset();
+        load_stats_.tags = loader.get_tag_counts();
+        for (auto i = start_error_count; i < errors_.size(); ++i)
+            ++load_stats_.errors[errors_[i].code];
+        monitor.report(loader);
+        return eof;
+    }
+
+    using SidecarKey = std::array<uint64_t, 3>;  // size, mtime, hash
+
+    // Size of the hashed blocks at the start, the middle and the end
+    // of the DXF file:
+    const std::size_t kSidecarHashBlockSize = 1 << 16;
+
+    static std::optional<SidecarKey>
+    sidecar_key(const std::string &filename) {
+        // Hashing the whole file would be as slow as the prescan, the
+        // sampled blocks detect changes which preserve the file size and the
+        // modification time in most cases.
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        auto const size = fs::file_size(filename, ec);
+        if (ec) return {};
+        auto const mtime = fs::last_write_time(filename, ec);
+        if (ec) return {};
+        auto stream = std::ifstream(filename, std::ios::binary);
+        if (!stream) return {};
+        auto buffer = std::string(kSidecarHashBlockSize, '\0');
+        uint64_t hash = utils::kFNVOffsetBasis;
+        auto const last_block =
+                size - std::min<uint64_t>(size, kSidecarHashBlockSize);
+        for (uint64_t offset : {uint64_t(0), size / 2, last_block}) {
+            stream.seekg(static_cast<std::streamoff>(offset));
+            stream.read(buffer.data(), kSidecarHashBlockSize);
+            hash = utils::fnv1a_hash(buffer.data(), stream.gcount(), hash);
+            stream.clear();
+        }
+        auto const ticks = mtime.time_since_epoch().count();
+        return SidecarKey{size, static_cast<uint64_t>(ticks), hash};
+    }
+
+    std::string sidecar_index_filename(const std::string &filename) {
+        return filename + ".ezidx";
+    }
+
+    static std::unique_ptr<std::istream>
+    open_binary(const std::string &filename) {
+        auto stream = std::make_unique<std::ifstream>(filename,
+                                                      std::ios::binary);
+        if (!*stream) return nullptr;
+        return stream;
+    }
+
+    Document readfile_indexed(const std::string &filename) {
+        auto const key = sidecar_key(filename);
+        if (!key) return Document();
+        auto const index_filename = sidecar_index_filename(filename);
+        if (auto index = std::ifstream(index_filename, std::ios::binary)) {
+            auto reader = BinaryReader(index);
+            auto stored_key = SidecarKey{};
+            for (auto &value : stored_key) reader.read(value);
+            auto doc = Document();
+            auto stream = open_binary(filename);
+            if (stream && reader.ok() && stored_key == *key &&
+                doc.load_lazy(std::move(stream), index)) {
+                doc.filename = filename;
+                return doc;
+            }
+        }
+        auto doc = readfile_lazy(filename);
+        if (!doc.is_lazy()) return doc;
+        // Write a temporary file and rename it, concurrent readers never
+        // see a partially written index file:
+        std::ostringstream tmp_filename;
+        tmp_filename << index_filename << '.'
+                     << std::this_thread::get_id() << ".tmp";
+        bool ok;
+        {
+            auto index = std::ofstream(tmp_filename.str(), std::ios::binary);
+            auto writer = BinaryWriter(index);
+            for (auto const value : *key) writer.write(value);
+            ok = writer.ok() && doc.save_lazy_index(index);
+        }
+        // A failed sidecar index is not an error, e.g. read-only folders:
+        std::error_code ec;
+        if (ok) std::filesystem::rename(tmp_filename.str(), index_filename, ec);
+        if (!ok || ec) std::filesystem::remove(tmp_filename.str(), ec);
         return doc;
-    } else {
-        return ezdxf::Document();
     }
-}
 
-bool ezdxf::Document::load(const ezdxf::tag::Loader &tags) {
-    return false;
+    bool Document::load_lazy(std::unique_ptr<std::istream> stream) {
+        // Returns true if the DXF structure was prescanned until the final
+        // (0, EOF) tag like load().
+        prepare_change();
+        auto const span = trace::Span("prescan");
+        if (objects_.size())
+            throw std::logic_error("lazy loading requires an empty document");
+        auto entries = std::vector<LazyEntry>{};
+        bool eof = false;
+        {
+            auto loader = tag::BasicLoader(*stream);
+            while (!loader.is_empty()) {
+                auto const &tag = loader.peek();
+                if (tag.equals(0, "SECTION")) {
+                    prescan_section(loader, entries);
+                } else if (tag.equals(0, "EOF")) {
+                    eof = true;
+                    break;
+                } else {
+                    log_structure_error("Unexpected tag outside of a section",
+                                        loader.get_line_number());
+                    loader.get();  // skip tag
+                }
+            }
+        }
+        auto index = LazyIndex();
+        for (auto &entry : entries) {
+            // Objects without handles get handles above the biggest handle
+            // in use, like by load():
+            if (!entry.handle) entry.handle = objects_.aquire_free_handle();
+            index.add(entry);
+        }
+        entries = std::vector<LazyEntry>{};  // free memory
+        for (auto const duplicate : index.build()) {
+            auto const &entry = index.entries()[duplicate];
+            std::ostringstream msg;
+            msg << std::uppercase << std::hex
+                << "Duplicate handle #" << entry.handle << std::dec
+                << " at byte offset " << entry.offset << ", object ignored";
+            errors_.emplace_back(ErrorCode::kDuplicateHandle, msg.str());
+        }
+        lazy_ = std::make_shared<LazyLoader>(std::move(stream),
+                                             std::move(index));
+        objects_.set_materializer([lazy = lazy_](Handle handle) {
+            return lazy->load(handle);
+        });
+        return eof;
+    }
+
+    bool Document::save_lazy_index(std::ostream &stream) const {
+        if (!lazy_) return false;
+        auto writer = BinaryWriter(stream);
+        writer.write(String(kLazyIndexMagic));
+        writer.write(kLazyIndexVersion);
+        writer.write(kByteOrderMark);
+        writer.write(static_cast<uint32_t>(sections_.size()));
+        for (auto const &section : sections_) {
+            writer.write(section.name);
+            writer.write(static_cast<uint32_t>(section.tags.size()));
+            for (auto const &tag : section.tags) {
+                writer.write(static_cast<int32_t>(tag.group_code()));
+                writer.write(tag.string());
+            }
+            writer.write(static_cast<uint32_t>(section.objects.size()));
+        }
+        writer.write(static_cast<uint32_t>(errors_.size()));
+        for (auto const &error : errors_) {
+            writer.write(error.code);
+            writer.write(error.message);
+        }
+        lazy_->index().write(writer);
+        return writer.ok();
+    }
+
+    bool Document::load_lazy(std::unique_ptr<std::istream> stream,
+                             std::istream &lazy_index) {
+        prepare_change();
+        if (objects_.size())
+            throw std::logic_error("lazy loading requires an empty document");
+        auto reader = BinaryReader(lazy_index);
+        String magic;
+        uint32_t version = 0, byte_order = 0;
+        reader.read(magic);
+        reader.read(version);
+        reader.read(byte_order);
+        if (!reader.ok() || magic != kLazyIndexMagic ||
+            version != kLazyIndexVersion || byte_order != kByteOrderMark)
+            return false;
+
+        // Restore all data before changing the document:
+        auto sections = std::vector<Section>{};
+        auto object_counts = std::vector<uint64_t>{};
+        uint32_t count = 0;
+        reader.read(count);
+        for (uint32_t i = 0; reader.ok() && i < count; ++i) {
+            String name;
+            uint32_t tag_count = 0;
+            reader.read(name);
+            reader.read(tag_count);
+            auto &section = sections.emplace_back(name);
+            for (uint32_t j = 0; reader.ok() && j < tag_count; ++j) {
+                int32_t code = 0;
+                String value;
+                reader.read(code);
+                if (reader.read(value)) section.tags.emplace_back(code, value);
+            }
+            uint32_t object_count = 0;
+            reader.read(object_count);
+            object_counts.push_back(object_count);
+        }
+        auto errors = ErrorMessages{};
+        reader.read(count);
+        for (uint32_t i = 0; reader.ok() && i < count; ++i) {
+            auto code = ErrorCode::kGenericError;
+            String message;
+            reader.read(code);
+            if (reader.read(message)) errors.emplace_back(code, message);
+        }
+        auto index = LazyIndex();
+        if (!reader.ok() || !index.read(reader)) return false;
+        // Each entry has a placeholder in a section, the object counts are
+        // checked before allocating the placeholders:
+        uint64_t placeholders = 0;
+        for (auto const object_count : object_counts)
+            placeholders += object_count;
+        if (placeholders != index.size()) return false;
+        for (auto const &entry : index.entries()) {
+            if (entry.section >= sections.size() ||
+                entry.position >= object_counts[entry.section])
+                return false;
+        }
+        for (std::size_t i = 0; i < sections.size(); ++i)
+            sections[i].objects.resize(object_counts[i], nullptr);
+
+        sections_ = std::move(sections);
+        errors_ = std::move(errors);
+        objects_.reserve_handles_until(index.max_handle());
+        lazy_ = std::make_shared<LazyLoader>(std::move(stream),
+                                             std::move(index));
+        objects_.set_materializer([lazy = lazy_](Handle handle) {
+            return lazy->load(handle);
+        });
+        return true;
+    }
+
+    void Document::prescan_section(tag::BasicLoader &loader,
+                                   std::vector<LazyEntry> &entries) {
+        loader.get();  // (0, SECTION)
+        if (loader.peek().group_code() != 2) {
+            log_structure_error("Missing section name",
+                                loader.get_line_number());
+            return;
+        }
+        sections_.emplace_back(loader.get().string());
+        if (is_object_section(sections_.back().name)) {
+            prescan_objects(loader, entries);
+        } else {
+            auto &tags = sections_.back().tags;
+            while (!loader.is_empty() &&
+                   !loader.peek().equals(0, "ENDSEC") &&
+                   !loader.peek().equals(0, "EOF")) {
+                tags.push_back(loader.get());
+            }
+        }
+        if (loader.peek().equals(0, "ENDSEC")) {
+            loader.get();
+        } else {
+            log_structure_error("Missing ENDSEC tag", loader.get_line_number());
+        }
+    }
+
+    static Handle prescan_handle(tag::BasicLoader &loader) {
+        // Returns the handle of the current DXF object and skips all tags
+        // until the next structure tag, returns 0 for missing or invalid
+        // handles.
+        Handle handle = 0;
+        while (!loader.is_empty() &&
+               loader.peek().group_code() != tag::GroupCode::kStructure) {
+            auto const tag = loader.get();
+            if (!handle && (tag.group_code() == 5 ||
+                            tag.group_code() == 105)) {
+                handle = utils::safe_str_to_handle(tag.string()).value_or(0);
+            }
+        }
+        return handle;
+    }
+
+    void Document::prescan_objects(tag::BasicLoader &loader,
+                                   std::vector<LazyEntry> &entries) {
+        // Records the location of the DXF objects, only the handle tags are
+        // decoded.
+        auto &section = sections_.back();
+        auto const section_index = static_cast<uint32_t>(sections_.size() - 1);
+        while (!loader.is_empty() &&
+               !loader.peek().equals(0, "ENDSEC") &&
+               !loader.peek().equals(0, "EOF")) {
+            if (loader.peek().group_code() != tag::GroupCode::kStructure) {
+                log_structure_error("Expected structure tag",
+                                    loader.get_line_number());
+                loader.get();  // skip tag
+                continue;
+            }
+            auto const offset = loader.get_offset();
+            auto const type = utils::str_to_dxf_type(loader.get().string());
+            Handle const handle = prescan_handle(loader);
+            objects_.reserve_handles_until(handle);
+            if (type == DXFType::Polyline) {
+                // The VERTEX and SEQEND entities are loaded as part of the
+                // POLYLINE entity and are not indexed:
+                while (!loader.is_empty() &&
+                       loader.peek().equals(0, "VERTEX")) {
+                    loader.get();
+                    objects_.reserve_handles_until(prescan_handle(loader));
+                }
+                if (!loader.is_empty() && loader.peek().equals(0, "SEQEND")) {
+                    loader.get();
+                    objects_.reserve_handles_until(prescan_handle(loader));
+                }
+            }
+            entries.push_back(LazyEntry{
+                    handle, type, section_index,
+                    static_cast<uint32_t>(section.objects.size()),
+                    offset, loader.get_offset() - offset});
+            section.objects.push_back(nullptr);  // placeholder
+        }
+    }
+
+    std::size_t Document::materialize_all() {
+        // Loads the not loaded objects in file order and replaces the
+        // placeholders in the sections.
+        auto const span = trace::Span("materialize all");
+        if (!lazy_) return 0;
+        std::size_t count = 0;
+        auto const &index = lazy_->index();
+        for (auto const &entry : index.entries()) {
+            // Placeholders of duplicate handles remain nullptr:
+            if (index.find(entry.handle) != &entry) continue;
+            Object *object = std::as_const(objects_).get(entry.handle);
+            if (!object) {
+                object = objects_.get(entry.handle);
+                ++count;
+            }
+            sections_[entry.section].objects[entry.position] = object;
+        }
+        for (auto &section : sections_) {
+            auto &objects = section.objects;
+            objects.erase(std::remove(objects.begin(), objects.end(),
+                                      nullptr), objects.end());
+        }
+        auto const &errors = lazy_->get_errors();
+        errors_.insert(errors_.end(), errors.begin(), errors.end());
+        objects_.set_materializer(nullptr);
+        lazy_.reset();  // closes the input stream
+        build_indices();
+        return count;
+    }
+
+    void Document::load_section(tag::AscLoader &loader,
+                                const EntityFilter &filter,
+                                LoadMonitor &monitor) {
+        loader.get();  // (0, SECTION)
+        if (loader.peek().group_code() != 2) {
+            log_structure_error("Missing section name",
+                                loader.get_line_number());
+            return;
+        }
+        sections_.emplace_back(loader.get().string());
+        auto &section = sections_.back();
+        auto const span = trace::Span("section", section.name);
+        if (is_object_section(section.name)) {
+            load_objects(loader, section, filter, monitor);
+        } else {
+            while (!loader.eof() &&
+                   !loader.peek().equals(0, "ENDSEC") &&
+                   !loader.peek().equals(0, "EOF") &&
+                   !monitor.poll(loader)) {
+                section.tags.push_back(loader.get());
+            }
+        }
+        if (monitor.is_cancelled()) return;
+        if (loader.peek().equals(0, "ENDSEC")) {
+            loader.get();
+        } else {
+            log_structure_error("Missing ENDSEC tag", loader.get_line_number());
+        }
+    }
+
+    void Document::load_objects(tag::AscLoader &loader, Section &section,
+                                const EntityFilter &filter,
+                                LoadMonitor &monitor) {
+        bool attribs = false;  // ATTRIB entities may follow
+        while (!loader.eof() &&
+               !loader.peek().equals(0, "ENDSEC") &&
+               !loader.peek().equals(0, "EOF") &&
+               !monitor.poll(loader)) {
+            if (loader.peek().group_code() != tag::GroupCode::kStructure) {
+                log_structure_error("Expected structure tag",
+                                    loader.get_line_number());
+                loader.get();  // skip tag
+                continue;
+            }
+            // The ATTRIB and SEQEND entities following an accepted INSERT
+            // entity are accepted together with the INSERT, skipped INSERT
+            // entities skip them, see load_filtered_object():
+            bool const attached = attribs &&
+                                  (loader.peek().equals(0, "ATTRIB") ||
+                                   loader.peek().equals(0, "SEQEND"));
+            auto object = attached ? acdb::load_object(loader, errors_)
+                                   : load_filtered_object(loader, filter);
+            attribs = object && (object->dxf_type() == DXFType::Insert ||
+                                 object->dxf_type() == DXFType::Attrib);
+            if (!object) continue;  // skipped entity
+            monitor.count_object(object->dxf_type());
+            auto const polyline =
+                    object->dxf_type() == DXFType::Polyline
+                    ? static_cast<const acdb::Polyline *>(object.get())
+                    : nullptr;
+            if (polyline) {
+                // The VERTEX and SEQEND entities are not stored in the
+                // object table, but their handles are in use:
+                objects_.reserve_handles_until(
+                        polyline->max_sequence_handle());
+            }
+            if (Handle duplicate = find_duplicate_handle(*object)) {
+                std::ostringstream msg;
+                msg << std::uppercase << std::hex
+                    << "Duplicate handle #" << duplicate << std::dec
+                    << " in line " << loader.get_line_number()
+                    << ", object ignored";
+                errors_.emplace_back(ErrorCode::kDuplicateHandle, msg.str());
+                continue;
+            }
+            if (polyline) {
+                auto const handles = polyline->sequence_handles();
+                sequence_handles_.insert(handles.begin(), handles.end());
+            }
+            Handle handle = object->get_handle();
+            // Adopted after the duplicate check, ignored objects have no
+            // row in the geometry store:
+            if (monitor.options().columnar_geometry)
+                object = geometry_->adopt(std::move(object));
+            if (handle == 0) {
+                pending_.push_back(PendingObject{
+                        sections_.size() - 1, section.objects.size(),
+                        std::move(object)});
+                section.objects.push_back(nullptr);  // placeholder
+            } else {
+                section.objects.push_back(objects_.store(std::move(object)));
+            }
+        }
+    }
+
+    Handle Document::find_duplicate_handle(const Object &object) const {
+        // Returns the first handle of the loaded or merged object which is
+        // already in use or 0. The handles of the VERTEX and SEQEND entities of a
+        // POLYLINE are checked against all handles in use and each other.
+        auto const in_use = [this](Handle h) {
+            return objects_.has(h) || sequence_handles_.count(h) != 0;
+        };
+        Handle const handle = object.get_handle();
+        if (object.dxf_type() != DXFType::Polyline)
+            return handle && in_use(handle) ? handle : 0;
+        auto handles = static_cast<const acdb::Polyline &>(object)
+                .sequence_handles();
+        if (handle) handles.push_back(handle);
+        std::sort(handles.begin(), handles.end());
+        for (std::size_t i = 0; i < handles.size(); ++i) {
+            if ((i && handles[i] == handles[i - 1]) || in_use(handles[i]))
+                return handles[i];
+        }
+        return 0;
+    }
+
+    std::unique_ptr<Object>
+    Document::load_filtered_object(tag::AscLoader &loader,
+                                   const EntityFilter &filter) {
+        // Returns nullptr for skipped entities. Entities of other types are
+        // skipped without decoding the tags, the layer filter requires to
+        // collect the tags until the layer is known.
+        auto const type = utils::str_to_dxf_type(loader.peek().string());
+        if (!filter.accepts_type(type)) {
+            skip_object(loader);
+            return nullptr;
+        }
+        if (type == DXFType::None || !filter.filters_layers())
+            return acdb::load_object(loader, errors_);
+
+        auto const line_number = loader.get_line_number();
+        auto const name = loader.get().string();
+        auto tags = tag::StringTags{};
+        String layer = "0";  // default layer
+        Handle handle = 0;
+        while (!loader.eof() &&
+               loader.peek().group_code() != tag::GroupCode::kStructure) {
+            tags.push_back(loader.get());
+            auto const &tag = tags.back();
+            if (tag.group_code() == 8) {
+                layer = tag.string();
+            } else if (!handle && tag.group_code() == 5) {
+                handle = utils::safe_str_to_handle(tag.string()).value_or(0);
+            }
+        }
+        if (filter.accepts_layer(layer)) {
+            auto object = acdb::load_object(name, std::move(tags), errors_,
+                                            line_number);
+            if (type == DXFType::Polyline) {
+                static_cast<acdb::Polyline *>(object.get())->load_sequence(
+                        loader, errors_);
+            }
+            return object;
+        }
+        if (handle) {
+            skipped_.push_back(handle);
+            objects_.reserve_handles_until(handle);
+        }
+        skip_sequence(loader, type);
+        return nullptr;
+    }
+
+    void Document::skip_object(tag::AscLoader &loader) {
+        // Skip all tags of the DXF object, only the handle is decoded to
+        // reserve the handle.
+        auto const type = utils::str_to_dxf_type(loader.peek().string());
+        loader.skip();  // structure tag
+        Handle handle = 0;
+        while (!loader.eof() &&
+               loader.peek().group_code() != tag::GroupCode::kStructure) {
+            if (!handle && loader.peek().group_code() == 5) {
+                handle = utils::safe_str_to_handle(loader.peek().string())
+                        .value_or(0);
+            }
+            loader.skip();
+        }
+        if (handle) {
+            skipped_.push_back(handle);
+            objects_.reserve_handles_until(handle);
+        }
+        skip_sequence(loader, type);
+    }
+
+    void Document::skip_sequence(tag::AscLoader &loader, const DXFType type) {
+        // Skip the VERTEX and SEQEND entities of a skipped POLYLINE and the
+        // ATTRIB and SEQEND entities of a skipped INSERT, the sequence is
+        // skipped as a unit.
+        char const *entity = nullptr;
+        if (type == DXFType::Polyline) {
+            entity = "VERTEX";
+        } else if (type == DXFType::Insert) {
+            entity = "ATTRIB";
+        } else {
+            return;
+        }
+        while (!loader.eof() && loader.peek().equals(0, entity))
+            skip_object(loader);
+        if (!loader.eof() && loader.peek().equals(0, "SEQEND"))
+            skip_object(loader);
+    }
+
+    void Document::assign_missing_handles() {
+        // Objects without handles (DXF R12, ENDTAB, ...) get handles above
+        // the biggest handle in use.
+        auto const span = trace::Span("assign handles");
+        for (auto &pending : pending_) {
+            pending.object->set_handle(objects_.aquire_free_handle());
+            sections_[pending.section].objects[pending.position] =
+                    objects_.store(std::move(pending.object));
+        }
+        pending_.clear();
+    }
+
+    void Document::build_indices(LoadStats *stats) {
+        // Records the wall time of the reference resolution and the index
+        // building in the optional load statistics.
+        using Clock = std::chrono::steady_clock;
+        auto start = Clock::now();
+        {
+            auto const span = trace::Span("resolve references");
+            auto findings = resolve_references(
+                    objects_, ThreadPool::global(), &skipped_);
+            std::move(findings.begin(), findings.end(),
+                      std::back_inserter(errors_));
+        }
+        auto resolved = Clock::now();
+        auto const span = trace::Span("build indices");
+        owners_.build(objects_);
+        types_.build(objects_);
+
+        modelspace_ = 0;
+        // A missing TABLES section is not created, e.g. DXF R12 files with
+        // an ENTITIES section only:
+        if (auto const tables = find_section("TABLES")) {
+            for (auto const object : tables->objects) {
+                auto record = dynamic_cast<acdb::RawObject *>(object);
+                if (!record || record->get_name() != "BLOCK_RECORD")
+                    continue;
+                auto name = record->find_raw_tag(2);
+                if (name && is_model_space_name(name->string())) {
+                    modelspace_ = record->get_handle();
+                    break;
+                }
+            }
+        }
+        if (stats) {
+            using Seconds = std::chrono::duration<double>;
+            stats->seconds[static_cast<std::size_t>(
+                    LoadPhase::kResolveReferences)] =
+                    Seconds(resolved - start).count();
+            stats->seconds[static_cast<std::size_t>(
+                    LoadPhase::kBuildIndices)] =
+                    Seconds(Clock::now() - resolved).count();
+        }
+    }
+
+    const Section *Document::find_section(const String &name) const {
+        // Returns the section by name or nullptr if the section does not
+        // exist.
+        auto it = std::find_if(sections_.begin(), sections_.end(),
+                               [&name](const Section &section) {
+                                   return section.name == name;
+                               });
+        return it != sections_.end() ? &*it : nullptr;
+    }
+
+    Section &Document::get_section(const String &name) {
+        // Returns the section by name, creates a new section if the section
+        // does not exist. New ENTITIES section are inserted in front of the
+        // OBJECTS section.
+        auto it = std::find_if(sections_.begin(), sections_.end(),
+                               [&name](const Section &section) {
+                                   return section.name == name;
+                               });
+        if (it != sections_.end()) return *it;
+        if (name == "ENTITIES") {
+            it = std::find_if(sections_.begin(), sections_.end(),
+                              [](const Section &section) {
+                                  return section.name == "OBJECTS";
+                              });
+            return *sections_.emplace(it, name);
+        }
+        return sections_.emplace_back(name);
+    }
+
+    Object *Document::add(std::unique_ptr<Object> object) {
+        // New graphical entities are stored in the ENTITIES section, all
+        // other objects in the OBJECTS section.
+        prepare_change();
+        if (object->get_handle() == 0)
+            object->set_handle(objects_.aquire_free_handle());
+        Object *ptr = objects_.store(std::move(object));
+        resolve_object_references(objects_, ptr, errors_, &skipped_);
+        owners_.add(ptr);
+        types_.add(ptr);
+        auto &section = get_section(
+                ptr->arx_type() == ARXType::AcDbEntity ? "ENTITIES"
+                                                       : "OBJECTS");
+        section.objects.push_back(ptr);
+        return ptr;
+    }
+
+    void Document::merge(std::vector<EntityBuilder> &builders) {
+        prepare_change();
+        for (auto const &builder : builders) {
+            if (builder.doc_ != this)
+                throw std::invalid_argument("builder of another document");
+        }
+        auto entities = std::vector<Object *>{};
+        auto objects = std::vector<Object *>{};
+        for (auto &builder : builders) {
+            for (auto &object : builder.objects_) {
+                // The handles of skipped entities are also in use:
+                Handle duplicate = find_duplicate_handle(*object);
+                if (!duplicate && is_ignored(&skipped_, object->get_handle()))
+                    duplicate = object->get_handle();
+                if (duplicate) {
+                    std::ostringstream msg;
+                    msg << std::uppercase << std::hex
+                        << "Duplicate handle #" << duplicate
+                        << " of merged object, object ignored";
+                    errors_.emplace_back(ErrorCode::kDuplicateHandle,
+                                         msg.str());
+                    continue;
+                }
+                if (object->dxf_type() == DXFType::Polyline) {
+                    auto const handles = static_cast<const acdb::Polyline *>(
+                            object.get())->sequence_handles();
+                    sequence_handles_.insert(handles.begin(), handles.end());
+                }
+                Object *ptr = objects_.store(std::move(object));
+                (ptr->arx_type() == ARXType::AcDbEntity ? entities : objects)
+                        .push_back(ptr);
+            }
+            builder.objects_.clear();
+        }
+        for (auto const &merged : {&entities, &objects}) {
+            for (auto const object : *merged)
+                resolve_object_references(objects_, object, errors_,
+                                          &skipped_);
+        }
+        // Rebuilding the indices by a counting sort is faster than adding
+        // many objects one by one:
+        owners_.build(objects_);
+        types_.build(objects_);
+        // get_section() may insert a new section, which invalidates
+        // references to the section objects:
+        if (!entities.empty()) {
+            auto &section = get_section("ENTITIES").objects;
+            section.insert(section.end(), entities.begin(), entities.end());
+        }
+        if (!objects.empty()) {
+            auto &section = get_section("OBJECTS").objects;
+            section.insert(section.end(), objects.begin(), objects.end());
+        }
+    }
+
+    void Document::erase(Object *object) {
+        prepare_change();
+        objects_.erase(object->get_handle());
+        types_.remove(object);
+    }
+
+    std::size_t Document::purge() {
+        prepare_change();
+        if (objects_.alive_count() == objects_.size()) return 0;
+        auto is_erased = [](const Object *object) {
+            return object->is_erased();
+        };
+        for (auto &section : sections_) {
+            auto &objects = section.objects;
+            objects.erase(std::remove_if(objects.begin(), objects.end(),
+                                         is_erased), objects.end());
+        }
+        auto purged_handles = std::vector<Handle>{};
+        objects_.for_each_erased([&purged_handles](const Object *object) {
+            purged_handles.push_back(object->get_handle());
+        });
+        std::sort(purged_handles.begin(), purged_handles.end());
+        // The rows of erased entities are removed before destroying them:
+        if (geometry_) geometry_->remove_erased();
+        const std::size_t purged = objects_.purge();
+        unlink_purged_objects(purged_handles);
+        owners_.build(objects_);
+        types_.build(objects_);
+        return purged;
+    }
+
+    void Document::unlink_purged_objects(const std::vector<Handle> &purged) {
+        // References to the destroyed objects are dangling now, only these
+        // references are reset and logged. All other references are
+        // unchanged and their findings are already logged.
+        auto const is_purged = [&purged](Handle handle) {
+            return handle &&
+                   std::binary_search(purged.begin(), purged.end(), handle);
+        };
+        for (auto const object : objects_) {
+            if (is_purged(object->get_owner())) {
+                object->set_owner_object(nullptr);
+                log_dangling_owner(errors_, object);
+            }
+            for (auto &ref : object->get_references()) {
+                if (!is_purged(ref.handle)) continue;
+                ref.object = nullptr;
+                log_dangling_pointer(errors_, object, ref);
+            }
+        }
+    }
+
+    void Document::freeze() {
+        // Build all lazy evaluated caches in advance, after freezing the
+        // document has no mutable state:
+        materialize_all();
+        (void) objects_.handle_order();
+        update_handle_order();
+        types_.compact();
+        frozen_ = true;
+    }
+
+    void Document::check_mutable() const {
+        if (frozen_) throw std::logic_error("document is frozen");
+    }
+
+    void Document::prepare_change() {
+        // Changing a partially loaded document is not supported:
+        check_mutable();
+        materialize_all();
+    }
+
+    void Document::export_dxf(std::ostream &stream, ExportOrder order) const {
+        if (lazy_) throw std::logic_error("document is not loaded completely");
+        auto const export_span = trace::Span("export");
+        auto writer = tag::AscWriter(stream);
+        if (order == ExportOrder::kHandleOrder) update_handle_order();
+        for (std::size_t index = 0; index < sections_.size(); ++index) {
+            auto const &section = sections_[index];
+            auto const span = trace::Span("export section", section.name);
+            writer.write(0, "SECTION");
+            writer.write(2, section.name);
+            for (auto const &tag : section.tags) writer.write(tag);
+            if (order == ExportOrder::kHandleOrder &&
+                is_sorted_section(section.name)) {
+                for (auto const object : handle_order_[index])
+                    object->export_dxf(writer);
+            } else {
+                for (auto const object : section.objects) {
+                    if (object->is_alive()) object->export_dxf(writer);
+                }
+            }
+            writer.write(0, "ENDSEC");
+        }
+        writer.write(0, "EOF");
+    }
+
+    static std::vector<Object *> sorted_objects(const Section &section) {
+        // Returns the alive objects of the section sorted by handle. The
+        // ATTRIB and SEQEND entities following an INSERT entity are a unit
+        // with the INSERT and sorted by the handle of the INSERT. The first
+        // object of the OBJECTS section is the root DICTIONARY, which stays
+        // the first object.
+        auto const &source = section.objects;
+        std::size_t const first =
+                section.name == "OBJECTS" && !source.empty() ? 1 : 0;
+        auto heads = std::vector<Object *>{};
+        heads.reserve(source.size());
+        // Attached entities [begin, end) of the INSERT entities:
+        auto sequences = std::unordered_map<
+                const Object *, std::pair<std::size_t, std::size_t>>{};
+        std::size_t i = first;
+        while (i < source.size()) {
+            Object *head = source[i];
+            std::size_t end = i + 1;
+            if (head->dxf_type() == DXFType::Insert) {
+                while (end < source.size() &&
+                       source[end]->dxf_type() == DXFType::Attrib)
+                    ++end;
+                if (end < source.size() &&
+                    source[end]->dxf_type() == DXFType::SeqEnd)
+                    ++end;
+                if (end > i + 1)
+                    sequences.emplace(head, std::make_pair(i + 1, end));
+            }
+            heads.push_back(head);
+            i = end;
+        }
+        sort_by_handle(heads);
+        auto objects = std::vector<Object *>{};
+        objects.reserve(source.size());
+        auto const append = [&objects](Object *object) {
+            if (object->is_alive()) objects.push_back(object);
+        };
+        if (first) append(source.front());
+        for (auto const head : heads) {
+            append(head);
+            if (sequences.empty()) continue;
+            if (auto it = sequences.find(head); it != sequences.end()) {
+                for (auto j = it->second.first; j < it->second.second; ++j)
+                    append(source[j]);
+            }
+        }
+        return objects;
+    }
+
+    void Document::update_handle_order() const {
+        // The objects of the sections are stored only together with a
+        // change of the object table, therefore the revision of the object
+        // table is also the revision of the sections.
+        if (handle_order_revision_ == objects_.revision() &&
+            handle_order_.size() == sections_.size())
+            return;
+        handle_order_.assign(sections_.size(), {});
+        for (std::size_t index = 0; index < sections_.size(); ++index) {
+            auto const &section = sections_[index];
+            if (is_sorted_section(section.name))
+                handle_order_[index] = sorted_objects(section);
+        }
+        handle_order_revision_ = objects_.revision();
+    }
+
+    void Document::log_structure_error(const String &message,
+                                       std::size_t line_number) {
+        std::ostringstream msg;
+        msg << message << " in line " << line_number;
+        errors_.emplace_back(ErrorCode::kInvalidStructure, msg.str());
+    }
 }
@@ -0,0 +1,190 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <typeinfo>
+#include "ezdxf/geometry_store.hpp"
+#include "ezdxf/utils.hpp"
+#include "ezdxf/acdb/columnar.hpp"
+
+namespace ezdxf {
+
+    GeometryColumns::GeometryColumns(DXFType type,
+                                     std::vector<std::vector<int>> groups) :
+            type_(type), groups_(std::move(groups)) {
+        for (auto const &group : groups_)
+            codes_.insert(codes_.end(), group.begin(), group.end());
+        columns_.resize(codes_.size());
+    }
+
+    std::size_t GeometryColumns::column_index(const int code) const {
+        for (std::size_t index = 0; index < codes_.size(); ++index) {
+            if (codes_[index] == code) return index;
+        }
+        throw std::invalid_argument("no geometry column for group code");
+    }
+
+    Span<Real> GeometryColumns::column(const int code) const {
+        return Span(columns_[column_index(code)]);
+    }
+
+    Real *GeometryColumns::column_data(const int code) {
+        return columns_[column_index(code)].data();
+    }
+
+    std::unique_ptr<acdb::ColumnarEntity>
+    GeometryColumns::adopt(acdb::Entity &entity) {
+        // The values are decoded into a new row, which is removed if the
+        // geometry tags do not match the groups.
+        for (auto &column : columns_) column.push_back(0.0);
+        auto const remove_row = [this]() {
+            for (auto &column : columns_) column.pop_back();
+            return nullptr;
+        };
+        auto const &raw_tags = entity.get_raw_tags();
+        auto tags = tag::StringTags{};
+        tags.reserve(raw_tags.size());
+        auto positions = acdb::ColumnarEntity::Positions{};
+        auto found = std::array<bool, kMaxGeometryGroups>{};
+        std::size_t index = 0;
+        while (index < raw_tags.size()) {
+            int const code = raw_tags[index].group_code();
+            auto const group = std::find_if(
+                    groups_.begin(), groups_.end(),
+                    [code](const std::vector<int> &g) {
+                        return g.front() == code;
+                    });
+            if (group == groups_.end()) {
+                // Geometry tags have to start a group:
+                if (std::find(codes_.begin(), codes_.end(), code) !=
+                    codes_.end())
+                    return remove_row();
+                tags.push_back(raw_tags[index++]);
+                continue;
+            }
+            auto const group_index = group - groups_.begin();
+            if (found[group_index] ||
+                index + group->size() > raw_tags.size())
+                return remove_row();
+            for (auto const group_code : *group) {
+                auto const &tag = raw_tags[index++];
+                if (tag.group_code() != group_code) return remove_row();
+                auto const value = utils::safe_str_to_real(tag.str());
+                if (!value) return remove_row();
+                columns_[column_index(group_code)].back() = *value;
+            }
+            found[group_index] = true;
+            positions[group_index] = static_cast<uint32_t>(tags.size());
+        }
+        for (std::size_t i = 0; i < groups_.size(); ++i) {
+            if (!found[i]) return remove_row();
+        }
+        auto columnar = std::make_unique<acdb::ColumnarEntity>(
+                std::move(entity), std::move(tags), *this, entities_.size(),
+                positions);
+        entities_.push_back(columnar.get());
+        return columnar;
+    }
+
+    void GeometryColumns::remove_erased() {
+        std::size_t count = 0;
+        for (std::size_t row = 0; row < entities_.size(); ++row) {
+            auto const entity = entities_[row];
+            if (entity->is_erased()) continue;
+            if (count != row) {
+                for (auto &column : columns_) column[count] = column[row];
+                entities_[count] = entity;
+                entity->set_row(count);
+            }
+            ++count;
+        }
+        for (auto &column : columns_) column.resize(count);
+        entities_.resize(count);
+    }
+
+    GeometryStore::GeometryStore() :
+            points_(DXFType::Point, {{10, 20, 30}}),
+            lines_(DXFType::Line, {{10, 20, 30}, {11, 21, 31}}),
+            circles_(DXFType::Circle, {{10, 20, 30}, {40}}),
+            arcs_(DXFType::Arc, {{10, 20, 30}, {40}, {50}, {51}}) {}
+
+    GeometryColumns *GeometryStore::columns(const DXFType type) {
+        switch (type) {
+            case DXFType::Point:
+                return &points_;
+            case DXFType::Line:
+                return &lines_;
+            case DXFType::Circle:
+                return &circles_;
+            case DXFType::Arc:
+                return &arcs_;
+            default:
+                return nullptr;
+        }
+    }
+
+    std::size_t GeometryStore::size() const {
+        return points_.size() + lines_.size() + circles_.size() +
+               arcs_.size();
+    }
+
+    std::unique_ptr<acdb::Object>
+    GeometryStore::adopt(std::unique_ptr<acdb::Object> object) {
+        // Only plain entities are adopted, specialized classes store their
+        // geometry by themselves:
+        auto entity = dynamic_cast<acdb::Entity *>(object.get());
+        if (!entity || typeid(*entity) != typeid(acdb::Entity) ||
+            !entity->is_loaded())
+            return object;
+        auto const columns = this->columns(entity->dxf_type());
+        if (!columns) return object;
+        auto columnar = columns->adopt(*entity);
+        if (!columnar) return object;
+        return columnar;
+    }
+
+    void GeometryStore::remove_erased() {
+        for (auto columns : {&points_, &lines_, &circles_, &arcs_})
+            columns->remove_erased();
+    }
+
+    std::optional<std::pair<math::Vec3, math::Vec3>>
+    GeometryStore::bounding_box() const {
+        if (points_.size() + lines_.size() == 0) return {};
+        // Axis index of the group codes: x=10, 11; y=20, 21; z=30, 31
+        auto min = std::array<Real, 3>{};
+        auto max = std::array<Real, 3>{};
+        min.fill(std::numeric_limits<Real>::infinity());
+        max.fill(-std::numeric_limits<Real>::infinity());
+        for (auto const columns : {&points_, &lines_}) {
+            for (auto const code : columns->codes()) {
+                auto const axis = code / 10 - 1;
+                Real lower = min[axis];
+                Real upper = max[axis];
+                for (auto const value : columns->column(code)) {
+                    lower = std::min(lower, value);
+                    upper = std::max(upper, value);
+                }
+                min[axis] = lower;
+                max[axis] = upper;
+            }
+        }
+        return std::make_pair(math::Vec3(min[0], min[1], min[2]),
+                              math::Vec3(max[0], max[1], max[2]));
+    }
+
+    void GeometryStore::translate(const Real dx, const Real dy,
+                                  const Real dz) {
+        auto const offset = std::array<Real, 3>{dx, dy, dz};
+        for (auto const columns : {&points_, &lines_}) {
+            auto const size = columns->size();
+            for (auto const code : columns->codes()) {
+                Real const delta = offset[code / 10 - 1];
+                Real *values = columns->column_data(code);
+                for (std::size_t i = 0; i < size; ++i) values[i] += delta;
+            }
+        }
+    }
+}
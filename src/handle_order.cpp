@@ -0,0 +1,53 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <algorithm>
+#include <array>
+#include <utility>
+#include "ezdxf/handle_order.hpp"
+
+namespace ezdxf {
+    // Comparison sort is faster for small object counts:
+    const std::size_t kMinRadixSortSize = 256;
+
+    void sort_by_handle(std::vector<Object *> &objects) {
+        const std::size_t size = objects.size();
+        if (size < kMinRadixSortSize) {
+            std::stable_sort(objects.begin(), objects.end(),
+                             [](const Object *a, const Object *b) {
+                                 return a->get_handle() < b->get_handle();
+                             });
+            return;
+        }
+        using Key = std::pair<Handle, Object *>;
+        // Load the handles once, avoids dereferencing the objects in each
+        // pass:
+        auto keys = std::vector<Key>{};
+        keys.reserve(size);
+        // Histograms of all 8 byte positions in a single pass:
+        auto counts = std::array<std::array<std::size_t, 256>, 8>{};
+        for (Object *object : objects) {
+            Handle handle = object->get_handle();
+            keys.emplace_back(handle, object);
+            for (int pass = 0; pass < 8; ++pass) {
+                ++counts[pass][(handle >> (pass << 3)) & 0xFF];
+            }
+        }
+        auto buffer = std::vector<Key>(size);
+        for (int pass = 0; pass < 8; ++pass) {
+            auto &count = counts[pass];
+            const int shift = pass << 3;
+            // All handles have the same byte at this position:
+            if (count[(keys[0].first >> shift) & 0xFF] == size) continue;
+            auto offsets = std::array<std::size_t, 256>{};
+            for (int i = 1; i < 256; ++i) {
+                offsets[i] = offsets[i - 1] + count[i - 1];
+            }
+            for (const Key &key : keys) {
+                buffer[offsets[(key.first >> shift) & 0xFF]++] = key;
+            }
+            keys.swap(buffer);
+        }
+        for (std::size_t i = 0; i < size; ++i) objects[i] = keys[i].second;
+    }
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include "ezdxf/lazy_index.hpp"
+#include "ezdxf/tag/loader.hpp"
+#include "ezdxf/acdb/factory.hpp"
+
+namespace ezdxf {
+
+    std::vector<uint32_t> LazyIndex::build() {
+        by_handle_.resize(entries_.size());
+        std::iota(by_handle_.begin(), by_handle_.end(), 0);
+        // The stable sort preserves the file order of duplicate handles:
+        std::stable_sort(by_handle_.begin(), by_handle_.end(),
+                         [this](uint32_t a, uint32_t b) {
+                             return entries_[a].handle < entries_[b].handle;
+                         });
+        auto duplicates = std::vector<uint32_t>{};
+        for (std::size_t i = 1; i < by_handle_.size(); ++i) {
+            if (entries_[by_handle_[i - 1]].handle ==
+                entries_[by_handle_[i]].handle)
+                duplicates.push_back(by_handle_[i]);
+        }
+        std::sort(duplicates.begin(), duplicates.end());
+        return duplicates;
+    }
+
+    const LazyEntry *LazyIndex::find(Handle handle) const {
+        auto it = std::lower_bound(
+                by_handle_.begin(), by_handle_.end(), handle,
+                [this](uint32_t index, Handle value) {
+                    return entries_[index].handle < value;
+                });
+        if (it == by_handle_.end() || entries_[*it].handle != handle)
+            return nullptr;
+        return &entries_[*it];
+    }
+
+    std::size_t LazyIndex::count(DXFType type) const {
+        return std::count_if(entries_.begin(), entries_.end(),
+                             [type](const LazyEntry &entry) {
+                                 return entry.type == type;
+                             });
+    }
+
+    void LazyIndex::write(BinaryWriter &writer) const {
+        writer.write(static_cast<uint64_t>(entries_.size()));
+        // Write members separately, the struct padding is undefined:
+        for (auto const &entry : entries_) {
+            writer.write(entry.handle);
+            writer.write(entry.type);
+            writer.write(entry.section);
+            writer.write(entry.position);
+            writer.write(entry.offset);
+            writer.write(entry.length);
+        }
+        for (auto const index : by_handle_) writer.write(index);
+    }
+
+    bool LazyIndex::read(BinaryReader &reader) {
+        entries_.clear();
+        by_handle_.clear();
+        uint64_t size = 0;
+        // Reject sizes beyond the 32-bit entry indices of by_handle_:
+        bool ok = reader.read(size) && size <= UINT32_MAX;
+        // Entries are appended one by one and not allocated in advance,
+        // a corrupt size value is detected by the end of the stream:
+        for (uint64_t i = 0; ok && i < size; ++i) {
+            LazyEntry entry{};
+            reader.read(entry.handle);
+            reader.read(entry.type);
+            reader.read(entry.section);
+            reader.read(entry.position);
+            reader.read(entry.offset);
+            ok = reader.read(entry.length) && entry.type >= DXFType::None &&
+                 entry.type <= DXFType::XLine;
+            if (ok) entries_.push_back(entry);
+        }
+        for (uint64_t i = 0; ok && i < size; ++i) {
+            uint32_t index = 0;
+            ok = reader.read(index) && index < size;
+            if (ok) by_handle_.push_back(index);
+        }
+        if (!ok) {
+            entries_.clear();
+            by_handle_.clear();
+        }
+        return ok;
+    }
+
+    std::unique_ptr<Object> LazyLoader::load(Handle handle) {
+        auto entry = index_.find(handle);
+        if (!entry) return nullptr;
+        buffer_.resize(entry->length);
+        stream_->clear();  // reset the EOF state of the prescan
+        stream_->seekg(static_cast<std::streamoff>(entry->offset));
+        stream_->read(buffer_.data(),
+                      static_cast<std::streamsize>(entry->length));
+        if (stream_->gcount() != static_cast<std::streamsize>(entry->length)) {
+            std::ostringstream msg;
+            msg << "Read error at byte offset " << entry->offset;
+            errors_.emplace_back(ErrorCode::kInvalidStructure, msg.str());
+            return nullptr;
+        }
+        auto basic_loader = tag::BasicLoader(buffer_);
+        auto loader = tag::AscLoader(basic_loader);
+        auto object = acdb::load_object(loader, errors_);
+        // Objects without a valid handle got their handle by the prescan:
+        if (object->get_handle() == 0) object->set_handle(handle);
+        return object;
+    }
+}
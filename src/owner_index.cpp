@@ -0,0 +1,39 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include "ezdxf/owner_index.hpp"
+
+namespace ezdxf {
+
+    void OwnerIndex::add(Object *object) {
+        Handle owner = object->get_owner();
+        if (owner) added_[owner].push_back(object);
+    }
+
+    Children OwnerIndex::children(Handle owner) const {
+        // Returns the children of the given owner handle in order of
+        // insertion. Does not transfer ownership!
+        Object *const *begin = nullptr;
+        Object *const *end = nullptr;
+        Object *const *added_begin = nullptr;
+        Object *const *added_end = nullptr;
+        if (auto row = rows_.find(owner); row != rows_.end()) {
+            begin = children_.data() + offsets_[row->second];
+            end = children_.data() + offsets_[row->second + 1];
+        }
+        if (auto added = added_.find(owner); added != added_.end()) {
+            added_begin = added->second.data();
+            added_end = added_begin + added->second.size();
+        }
+        return {begin, end, added_begin, added_end};
+    }
+
+    std::size_t OwnerIndex::owner_count() const {
+        // Returns the count of owners with at least one child.
+        std::size_t count = rows_.size();
+        for (auto const &[owner, children] : added_) {
+            if (rows_.find(owner) == rows_.end()) ++count;
+        }
+        return count;
+    }
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <fstream>
+#include "ezdxf/probe.hpp"
+#include "ezdxf/utils.hpp"
+
+namespace ezdxf {
+
+    static Real real_value(const String &s) {
+        return utils::safe_str_to_real(s).value_or(0.0);
+    }
+
+    static Vec3 set_axis(const Vec3 &v, int code, Real value) {
+        // Set the axis of a vector by the group code 10, 20 or 30.
+        switch (code) {
+            case 10:
+                return {value, v.y(), v.z()};
+            case 20:
+                return {v.x(), value, v.z()};
+            case 30:
+                return {v.x(), v.y(), value};
+            default:
+                return v;
+        }
+    }
+
+    HeaderInfo probe(tag::AscLoader &loader) {
+        auto info = HeaderInfo{};
+        if (!loader.peek().equals(0, "SECTION")) return info;
+        loader.get();
+        if (!loader.peek().equals(2, "HEADER")) return info;
+        loader.get();
+        info.valid = true;
+        bool has_extmin = false, has_extmax = false;
+        String name{};  // name of the current header variable
+        while (!loader.eof() &&
+               loader.peek().group_code() != tag::GroupCode::kStructure) {
+            auto tag = loader.get();
+            int code = tag.group_code();
+            if (code == 9) {
+                name = tag.string();
+            } else if (name == "$ACADVER" && code == 1) {
+                info.acadver = tag.string();
+                info.version = utils::str_to_dxf_version(tag.string());
+            } else if (name == "$HANDSEED" && code == 5) {
+                info.handseed =
+                        utils::safe_str_to_handle(tag.string()).value_or(0);
+            } else if (name == "$EXTMIN") {
+                info.extmin = set_axis(info.extmin, code,
+                                       real_value(tag.string()));
+                has_extmin = true;
+            } else if (name == "$EXTMAX") {
+                info.extmax = set_axis(info.extmax, code,
+                                       real_value(tag.string()));
+                has_extmax = true;
+            } else if (name == "$INSUNITS" && code == 70) {
+                info.insunits = static_cast<int>(
+                        utils::safe_str_to_int64(tag.string()).value_or(0));
+            } else if (name == "$DWGCODEPAGE" && code == 3) {
+                info.codepage = tag.string();
+            }
+        }
+        info.has_extents = has_extmin && has_extmax;
+        return info;
+    }
+
+    HeaderInfo probe(const std::string &filename) {
+        auto stream = std::ifstream(filename, std::ios::binary);
+        if (!stream) return HeaderInfo{};
+        auto basic_loader = tag::BasicLoader(stream);
+        auto loader = tag::AscLoader(basic_loader);
+        return probe(loader);
+    }
+}
@@ -0,0 +1,25 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include "ezdxf/resolver.hpp"
+
+namespace ezdxf {
+
+    void log_dangling_owner(ErrorMessages &errors, const Object *object) {
+        std::ostringstream msg;
+        msg << std::uppercase << std::hex
+            << "Dangling owner handle #" << object->get_owner()
+            << " in object #" << object->get_handle();
+        errors.emplace_back(ErrorCode::kDanglingOwnerHandle, msg.str());
+    }
+
+    void log_dangling_pointer(ErrorMessages &errors, const Object *object,
+                              const acdb::Reference &ref) {
+        std::ostringstream msg;
+        msg << std::uppercase << std::hex
+            << "Dangling pointer handle #" << ref.handle
+            << " in object #" << object->get_handle()
+            << std::dec << " (group code " << ref.code << ")";
+        errors.emplace_back(ErrorCode::kDanglingPointerHandle, msg.str());
+    }
+}
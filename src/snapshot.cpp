@@ -0,0 +1,442 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/lazy_index.hpp"
+#include "ezdxf/snapshot.hpp"
+#include "ezdxf/trace.hpp"
+#include "ezdxf/utils.hpp"
+#include "ezdxf/acdb/entity.hpp"
+#include "ezdxf/acdb/lwpolyline.hpp"
+#include "ezdxf/acdb/mesh.hpp"
+#include "ezdxf/acdb/polyline.hpp"
+
+namespace ezdxf {
+    using namespace ezdxf::snapshot;
+
+    namespace {
+        class SnapshotWriter {
+            // Collects the records and the string arena of a snapshot.
+        public:
+            std::vector<SectionRecord> sections{};
+            std::vector<ObjectRecord> objects{};
+            std::vector<TagRecord> tags{};
+            std::vector<ReferenceRecord> references{};
+            std::vector<ErrorRecord> errors{};
+            std::vector<Handle> skipped{};
+            std::vector<Handle> sequence_handles{};
+            std::string arena{};
+
+            StringRef add_string(const String &s) {
+                StringRef ref{arena.size(), s.size()};
+                arena += s;
+                return ref;
+            }
+
+            void add_tag(const tag::StringTag &tag) {
+                TagRecord record{};
+                record.value = add_string(tag.str());
+                record.code = tag.group_code();
+                tags.push_back(record);
+            }
+
+            void add_tags(const tag::StringTags &string_tags) {
+                for (auto const &tag : string_tags) add_tag(tag);
+            }
+
+            void add_object(const Object *object) {
+                ObjectRecord record{};
+                record.handle = object->get_handle();
+                record.owner = object->get_owner();
+                record.kind = ObjectKind::kObject;
+                record.type = object->dxf_type();
+                record.first_tag = tags.size();
+                if (auto raw = dynamic_cast<const acdb::RawObject *>(object)) {
+                    record.kind = ObjectKind::kRawObject;
+                    record.name = add_string(raw->get_name());
+                    if (raw->is_loaded()) {
+                        record.flags |= kLoaded;
+                        // Specialized classes rebuild their decoded tags:
+                        raw->for_each_tag([this](const tag::StringTag &tag) {
+                            add_tag(tag);
+                        });
+                    }
+                }
+                if (auto entity = dynamic_cast<const acdb::Entity *>(object)) {
+                    record.kind = ObjectKind::kEntity;
+                    record.layer = add_string(entity->get_layer());
+                }
+                record.tag_count = tags.size() - record.first_tag;
+                record.first_reference = references.size();
+                for (auto const &ref : object->get_references()) {
+                    ReferenceRecord reference{};
+                    reference.handle = ref.handle;
+                    reference.code = ref.code;
+                    references.push_back(reference);
+                }
+                record.reference_count =
+                        references.size() - record.first_reference;
+                objects.push_back(record);
+            }
+
+            template<typename T>
+            static Array append(std::string &payload,
+                                const std::vector<T> &records) {
+                // All record sizes are multiples of 8, the records stay
+                // aligned without padding:
+                Array array{payload.size(), records.size()};
+                payload.append(reinterpret_cast<const char *>(records.data()),
+                               records.size() * sizeof(T));
+                return array;
+            }
+
+            std::string payload(Handle max_handle) const {
+                auto result = std::string(sizeof(Directory), '\0');
+                Directory directory{};
+                directory.sections = append(result, sections);
+                directory.objects = append(result, objects);
+                directory.tags = append(result, tags);
+                directory.references = append(result, references);
+                directory.errors = append(result, errors);
+                directory.skipped = append(result, skipped);
+                directory.sequence_handles = append(result, sequence_handles);
+                directory.arena = Array{result.size(), arena.size()};
+                directory.max_handle = max_handle;
+                result += arena;
+                result.resize((result.size() + 7) & ~std::size_t(7), '\0');
+                std::memcpy(result.data(), &directory, sizeof(Directory));
+                return result;
+            }
+        };
+
+        class SnapshotReader {
+            // Validates and reads the records of a snapshot payload in place.
+        private:
+            const char *data_;
+            uint64_t size_;
+            Directory directory_{};
+
+            template<typename T>
+            [[nodiscard]] bool is_valid(const Array &array) const {
+                return array.offset % 8 == 0 && array.offset <= size_ &&
+                       array.count <= (size_ - array.offset) / sizeof(T);
+            }
+
+        public:
+            SnapshotReader(const char *data, uint64_t size) :
+                    data_(data), size_(size) {}
+
+            bool read_directory() {
+                if (size_ < sizeof(Directory)) return false;
+                std::memcpy(&directory_, data_, sizeof(Directory));
+                return is_valid<SectionRecord>(directory_.sections) &&
+                       is_valid<ObjectRecord>(directory_.objects) &&
+                       is_valid<TagRecord>(directory_.tags) &&
+                       is_valid<ReferenceRecord>(directory_.references) &&
+                       is_valid<ErrorRecord>(directory_.errors) &&
+                       is_valid<Handle>(directory_.skipped) &&
+                       is_valid<Handle>(directory_.sequence_handles) &&
+                       directory_.arena.offset <= size_ &&
+                       directory_.arena.count <=
+                       size_ - directory_.arena.offset;
+            }
+
+            [[nodiscard]] const Directory &directory() const {
+                return directory_;
+            }
+
+            template<typename T>
+            [[nodiscard]] const T *records(const Array &array) const {
+                return reinterpret_cast<const T *>(data_ + array.offset);
+            }
+
+            [[nodiscard]] bool is_valid(const StringRef &ref) const {
+                return ref.offset <= directory_.arena.count &&
+                       ref.size <= directory_.arena.count - ref.offset;
+            }
+
+            [[nodiscard]] bool is_valid_range(uint64_t first, uint64_t count,
+                                              const Array &array) const {
+                return first <= array.count && count <= array.count - first;
+            }
+
+            [[nodiscard]] String string(const StringRef &ref) const {
+                return {data_ + directory_.arena.offset + ref.offset,
+                        static_cast<std::size_t>(ref.size)};
+            }
+
+            [[nodiscard]] bool is_valid_handles(const Array &array) const {
+                // Handle arrays are sorted without duplicates and without
+                // the 0 handle:
+                auto const handles = records<Handle>(array);
+                for (uint64_t i = 0; i < array.count; ++i) {
+                    if (handles[i] <= (i ? handles[i - 1] : 0)) return false;
+                }
+                return true;
+            }
+
+            [[nodiscard]] std::vector<Handle> handles(
+                    const Array &array) const {
+                auto const first = records<Handle>(array);
+                return {first, first + array.count};
+            }
+
+            [[nodiscard]] tag::StringTags tags(uint64_t first,
+                                               uint64_t count) const {
+                auto result = tag::StringTags{};
+                result.reserve(count);
+                auto const records =
+                        this->records<TagRecord>(directory_.tags) + first;
+                for (uint64_t i = 0; i < count; ++i) {
+                    result.emplace_back(records[i].code,
+                                        string(records[i].value));
+                }
+                return result;
+            }
+        };
+
+        bool is_valid_object(const SnapshotReader &reader,
+                             const ObjectRecord &record) {
+            auto const &directory = reader.directory();
+            if (record.kind > ObjectKind::kEntity ||
+                record.type < DXFType::None || record.type > DXFType::XLine ||
+                (record.flags & ~kLoaded) != 0)
+                return false;
+            // Only acdb::RawObject and derived classes have raw tags:
+            if ((record.flags & kLoaded) &&
+                record.kind == ObjectKind::kObject)
+                return false;
+            return reader.is_valid(record.name) &&
+                   reader.is_valid(record.layer) &&
+                   reader.is_valid_range(record.first_tag, record.tag_count,
+                                         directory.tags) &&
+                   reader.is_valid_range(record.first_reference,
+                                         record.reference_count,
+                                         directory.references);
+        }
+
+        bool is_valid_snapshot(const SnapshotReader &reader) {
+            auto const &directory = reader.directory();
+            auto const sections =
+                    reader.records<SectionRecord>(directory.sections);
+            for (uint64_t i = 0; i < directory.sections.count; ++i) {
+                auto const &section = sections[i];
+                if (!reader.is_valid(section.name) ||
+                    !reader.is_valid_range(section.first_tag,
+                                           section.tag_count, directory.tags) ||
+                    !reader.is_valid_range(section.first_object,
+                                           section.object_count,
+                                           directory.objects))
+                    return false;
+            }
+            auto const objects =
+                    reader.records<ObjectRecord>(directory.objects);
+            for (uint64_t i = 0; i < directory.objects.count; ++i) {
+                if (!is_valid_object(reader, objects[i])) return false;
+            }
+            auto const references =
+                    reader.records<ReferenceRecord>(directory.references);
+            for (uint64_t i = 0; i < directory.references.count; ++i) {
+                if (!acdb::is_pointer_group_code(references[i].code))
+                    return false;
+            }
+            auto const tags = reader.records<TagRecord>(directory.tags);
+            for (uint64_t i = 0; i < directory.tags.count; ++i) {
+                if (!reader.is_valid(tags[i].value)) return false;
+            }
+            auto const errors = reader.records<ErrorRecord>(directory.errors);
+            for (uint64_t i = 0; i < directory.errors.count; ++i) {
+                auto const code = errors[i].code;
+                if (!reader.is_valid(errors[i].message) ||
+                    code < ErrorCode::kGenericError ||
+                    code > ErrorCode::kLoadingCancelled)
+                    return false;
+            }
+            return reader.is_valid_handles(directory.skipped) &&
+                   reader.is_valid_handles(directory.sequence_handles);
+        }
+
+        std::unique_ptr<acdb::Entity> create_entity(DXFType type,
+                                                    const String &name) {
+            // Specialized classes decode their tags by load_tags():
+            if (type == DXFType::LwPolyline)
+                return std::make_unique<acdb::LwPolyline>();
+            if (type == DXFType::Mesh) return std::make_unique<acdb::Mesh>();
+            if (type == DXFType::Polyline)
+                return std::make_unique<acdb::Polyline>();
+            return std::make_unique<acdb::Entity>(type, name);
+        }
+
+        std::unique_ptr<Object> create_object(const SnapshotReader &reader,
+                                              const ObjectRecord &record) {
+            auto object = std::unique_ptr<Object>{};
+            switch (record.kind) {
+                case ObjectKind::kObject:
+                    object = std::make_unique<Object>();
+                    break;
+                case ObjectKind::kRawObject:
+                    object = std::make_unique<acdb::RawObject>(
+                            reader.string(record.name));
+                    break;
+                case ObjectKind::kEntity: {
+                    auto entity = create_entity(
+                            record.type, reader.string(record.name));
+                    entity->set_layer(reader.string(record.layer));
+                    object = std::move(entity);
+                    break;
+                }
+            }
+            object->set_handle(record.handle);
+            object->set_owner(record.owner);
+            if (record.flags & kLoaded) {
+                // The stored errors replace all loading errors, see
+                // load_snapshot():
+                ErrorMessages errors{};
+                static_cast<acdb::RawObject *>(object.get())->load_tags(
+                        reader.tags(record.first_tag, record.tag_count),
+                        errors, 0);
+            }
+            auto const references = reader.records<ReferenceRecord>(
+                    reader.directory().references) + record.first_reference;
+            for (uint64_t i = 0; i < record.reference_count; ++i) {
+                object->add_reference(references[i].code,
+                                      references[i].handle);
+            }
+            return object;
+        }
+    }
+
+    bool Document::save_snapshot(std::ostream &stream) const {
+        // Erased objects are not stored, the owner and type indices are
+        // rebuilt by loading, which is faster than storing them.
+        auto const span = trace::Span("save snapshot");
+        if (lazy_) throw std::logic_error("document is not loaded completely");
+        auto writer = SnapshotWriter();
+        for (auto const &section : sections_) {
+            SectionRecord record{};
+            record.name = writer.add_string(section.name);
+            record.first_tag = writer.tags.size();
+            writer.add_tags(section.tags);
+            record.tag_count = writer.tags.size() - record.first_tag;
+            record.first_object = writer.objects.size();
+            for (auto const object : section.objects) {
+                if (object->is_alive()) writer.add_object(object);
+            }
+            record.object_count = writer.objects.size() - record.first_object;
+            writer.sections.push_back(record);
+        }
+        for (auto const &error : errors_) {
+            ErrorRecord record{};
+            record.message = writer.add_string(error.message);
+            record.code = error.code;
+            writer.errors.push_back(record);
+        }
+        writer.skipped = skipped_;
+        writer.sequence_handles.assign(sequence_handles_.begin(),
+                                       sequence_handles_.end());
+        std::sort(writer.sequence_handles.begin(),
+                  writer.sequence_handles.end());
+        // Reserved handles are not reused after loading:
+        auto const payload = writer.payload(objects_.max_handle());
+
+        Header header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.byte_order = kByteOrderMark;
+        header.payload_size = payload.size();
+        header.checksum = utils::fnv1a_hash(payload.data(), payload.size());
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+        stream.write(payload.data(),
+                     static_cast<std::streamsize>(payload.size()));
+        return stream.good();
+    }
+
+    bool Document::load_snapshot(std::istream &stream) {
+        auto const span = trace::Span("load snapshot");
+        prepare_change();
+        if (objects_.size() || !sections_.empty())
+            throw std::logic_error("loading a snapshot requires an empty "
+                                   "document");
+        Header header{};
+        stream.read(reinterpret_cast<char *>(&header), sizeof(Header));
+        if (stream.gcount() != sizeof(Header) ||
+            std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+            header.version != kVersion || header.byte_order != kByteOrderMark)
+            return false;
+        // Check the payload size of seekable streams before allocating the
+        // buffer:
+        if (auto const position = stream.tellg(); position != -1) {
+            stream.seekg(0, std::ios::end);
+            auto const end = stream.tellg();
+            stream.seekg(position);
+            if (uint64_t(end - position) < header.payload_size) return false;
+        }
+        // The uint64_t buffer guarantees the alignment of the records:
+        auto buffer = std::vector<uint64_t>((header.payload_size + 7) / 8);
+        auto const data = reinterpret_cast<char *>(buffer.data());
+        stream.read(data, static_cast<std::streamsize>(header.payload_size));
+        if (uint64_t(stream.gcount()) != header.payload_size ||
+            utils::fnv1a_hash(data, header.payload_size) != header.checksum)
+            return false;
+
+        auto reader = SnapshotReader(data, header.payload_size);
+        if (!reader.read_directory() || !is_valid_snapshot(reader))
+            return false;
+        // The snapshot is loaded into a new document, this document is
+        // replaced only if the snapshot was loaded successfully:
+        auto doc = Document();
+        auto const &directory = reader.directory();
+        auto const section_records =
+                reader.records<SectionRecord>(directory.sections);
+        auto const object_records =
+                reader.records<ObjectRecord>(directory.objects);
+        for (uint64_t i = 0; i < directory.sections.count; ++i) {
+            auto const &record = section_records[i];
+            auto &section =
+                    doc.sections_.emplace_back(reader.string(record.name));
+            section.tags = reader.tags(record.first_tag, record.tag_count);
+            for (uint64_t j = 0; j < record.object_count; ++j) {
+                auto object = create_object(
+                        reader, object_records[record.first_object + j]);
+                Handle handle = object->get_handle();
+                if (handle == 0 || doc.objects_.has(handle)) return false;
+                section.objects.push_back(
+                        doc.objects_.store(std::move(object)));
+            }
+        }
+        doc.objects_.reserve_handles_until(directory.max_handle);
+        doc.skipped_ = reader.handles(directory.skipped);
+        auto const sequence_handles =
+                reader.handles(directory.sequence_handles);
+        doc.sequence_handles_.insert(sequence_handles.begin(),
+                                     sequence_handles.end());
+        doc.build_indices();
+        // The stored errors include the audit findings of build_indices():
+        doc.errors_.clear();
+        auto const error_records =
+                reader.records<ErrorRecord>(directory.errors);
+        for (uint64_t i = 0; i < directory.errors.count; ++i) {
+            doc.errors_.emplace_back(error_records[i].code,
+                                     reader.string(error_records[i].message));
+        }
+        doc.filename = std::move(filename);
+        *this = std::move(doc);
+        return true;
+    }
+
+    Document readsnapshot(const std::string &filename) {
+        auto doc = Document();
+        auto stream = std::ifstream(filename, std::ios::binary);
+        if (stream && doc.load_snapshot(stream)) doc.filename = filename;
+        return doc;
+    }
+
+    bool writesnapshot(const Document &doc, const std::string &filename) {
+        auto stream = std::ofstream(filename, std::ios::binary);
+        return stream && doc.save_snapshot(stream);
+    }
+}
@@ -21,6 +21,11 @@ namespace ezdxf::tag {
         }
     }
 
+    BasicLoader::BasicLoader(std::istream &stream) {
+        input_stream = &stream;
+        current = load_next();
+    }
+
     BasicLoader::~BasicLoader() {
         if (input_stream && is_stream_owner) {
             delete input_stream;
@@ -30,7 +35,7 @@ namespace ezdxf::tag {
 
     StringTag BasicLoader::get() {
         // Returns the current tag and loads the next tag from stream.
-        auto value = current;
+        auto value = std::move(current);
         current = load_next();
         return value;
     }
@@ -44,11 +49,14 @@ namespace ezdxf::tag {
         String value;
         // Skip comment tags with group code 999:
         while (code == GroupCode::kComment) {
+            current_offset = offset;
             // Read next group code tag or EOF
             input_stream->getline(buffer, kMaxLineBuffer);
             if (input_stream->fail()) {
                 return error;
             }
+            // gcount() includes the extracted line ending <LF>:
+            offset += input_stream->gcount();
             line_number++;
             code = utils::safe_group_code(buffer);
             if (code == GroupCode::kError) {
@@ -60,6 +68,7 @@ namespace ezdxf::tag {
             if (input_stream->fail()) {
                 return error;
             }
+            offset += input_stream->gcount();
             line_number++;
             value = String(buffer);
             if (code == GroupCode::kStructure) {
@@ -82,6 +91,9 @@ namespace ezdxf::tag {
     void AscLoader::load_next_tag() {
         line_number = loader.get_line_number();
         current = loader.get();
+        if (!current.is_error_tag())
+            ++tag_counts[static_cast<size_t>(
+                    group_code_type(current.group_code()))];
     }
 
     TagType AscLoader::detect_current_type() const {
@@ -199,6 +211,7 @@ namespace ezdxf::tag {
             log_invalid_real_value();
             return make_error_tag();
         }
+        load_next_tag();
         if (current.group_code() == code + 10) {
             auto opt_y = utils::safe_str_to_real(current.string());
             if (opt_y) {
@@ -10,31 +10,7 @@ namespace ezdxf::tag {
         return (code >= 0 && code < kGroupCodeCount);
     }
 
-    class TypeCache {
-        TagType cache[kGroupCodeCount]{}; // init with 0 == TagType::kUndefined
-    public:
-        TypeCache() = default;
-
-        TagType get(const int code) {
-            return is_group_code_in_range(code) ? cache[code]
-                                                : TagType::kUndefined;
-        }
-
-        void set(const int code, const TagType tag_type) {
-            if (is_group_code_in_range(code)) {
-                cache[code] = tag_type;
-            }
-        }
-    };
-
-    TagType group_code_type(const int code) {
-        static auto cache = TypeCache();
-        if (!is_group_code_in_range(code)) {
-            return TagType::kUndefined;
-        }
-        if (auto tag_type = cache.get(code); tag_type != TagType::kUndefined) {
-            return tag_type;
-        }
+    static TagType compute_group_code_type(const int code) {
         TagType tag_type = TagType::kString; // default value
         if ((code >= 10 && code < 19) ||
             (code >= 110 && code < 113) ||
@@ -60,10 +36,41 @@ namespace ezdxf::tag {
         } else if ((code >= 310 && code < 320) || code == 1004) {
             tag_type = TagType::kBinaryData;
         }
-        cache.set(code, tag_type);
         return tag_type;
     }
 
+    class TypeCache {
+        TagType cache[kGroupCodeCount]{}; // init with 0 == TagType::kUndefined
+    public:
+        TypeCache() = default;
+
+        [[nodiscard]] TagType get(const int code) const {
+            return is_group_code_in_range(code) ? cache[code]
+                                                : TagType::kUndefined;
+        }
+
+        void set(const int code, const TagType tag_type) {
+            if (is_group_code_in_range(code)) {
+                cache[code] = tag_type;
+            }
+        }
+    };
+
+    TagType group_code_type(const int code) {
+        // The cache is filled completely at the first call and read-only
+        // afterwards, which makes this function thread safe for parallel
+        // loading, the initialization of static local variables is
+        // thread safe:
+        static const auto cache = []() {
+            auto types = TypeCache();
+            for (int i = 0; i < kGroupCodeCount; ++i) {
+                types.set(i, compute_group_code_type(i));
+            }
+            return types;
+        }();
+        return cache.get(code);
+    }
+
     bool is_valid_group_code(int64_t code) {
         return (code >= 0) && (code < kGroupCodeCount);
     }
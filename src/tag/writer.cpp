@@ -0,0 +1,28 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <iomanip>
+#include <string>
+#include "ezdxf/tag/writer.hpp"
+#include "ezdxf/utils.hpp"
+
+namespace ezdxf::tag {
+
+    void AscWriter::write(const int code, const String &value) {
+        // Group codes are right aligned in a 3 char wide column like
+        // AutoCAD does:
+        output_stream << std::setw(3) << code << '\n' << value << '\n';
+    }
+
+    void AscWriter::write_handle(const int code, const Handle handle) {
+        write(code, utils::handle_to_str(handle));
+    }
+
+    void AscWriter::write_real(const int code, const Real value) {
+        write(code, utils::real_to_str(value));
+    }
+
+    void AscWriter::write_integer(const int code, const int64_t value) {
+        write(code, std::to_string(value));
+    }
+}
@@ -0,0 +1,107 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <algorithm>
+#include <string>
+#include "ezdxf/thread_pool.hpp"
+#include "ezdxf/trace.hpp"
+
+namespace ezdxf {
+    // Identifies the pool and the queue of the current worker thread:
+    static thread_local ThreadPool *current_pool = nullptr;
+    static thread_local unsigned int current_index = 0;
+
+    ThreadPool::ThreadPool(unsigned int thread_count) {
+        if (thread_count == 0)
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned int i = 0; i < thread_count; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        for (unsigned int i = 0; i < thread_count; ++i) {
+            workers_.emplace_back(&ThreadPool::work, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        // Pending tasks are processed before the workers stop.
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto &worker : workers_) worker.join();
+    }
+
+    ThreadPool &ThreadPool::global() {
+        static ThreadPool pool{};
+        return pool;
+    }
+
+    void ThreadPool::submit(Task task) {
+        unsigned int index = current_pool == this
+                             ? current_index
+                             : next_queue_++ % size();
+        {
+            // The pending count is incremented in front of queueing the task
+            // and under the wake mutex, which prevents lost wake ups and a
+            // pending count below the real count of queued tasks:
+            std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+            ++pending_;
+            std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+        wake_.notify_one();
+    }
+
+    bool ThreadPool::pop_task(unsigned int index, Task &task) {
+        // Take the newest task of the own queue, this is most likely the
+        // task with the "hottest" data:
+        {
+            auto &queue = *queues_[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                --pending_;
+                return true;
+            }
+        }
+        // Steal the oldest task of the other queues:
+        for (unsigned int i = 1; i < size(); ++i) {
+            auto &queue = *queues_[(index + i) % size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                --pending_;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ThreadPool::run_pending_task() {
+        Task task;
+        unsigned int index = current_pool == this ? current_index : 0;
+        if (!pop_task(index, task)) return false;
+        task();
+        return true;
+    }
+
+    void ThreadPool::work(unsigned int index) {
+        current_pool = this;
+        current_index = index;
+        trace::set_thread_name("worker " + std::to_string(index));
+        Task task;
+        while (true) {
+            if (pop_task(index, task)) {
+                task();
+                task = nullptr;  // release captured data
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_.wait(lock, [this]() { return stop_ || pending_ > 0; });
+            if (stop_ && pending_ == 0) return;
+        }
+    }
+}
@@ -0,0 +1,187 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "ezdxf/trace.hpp"
+
+namespace ezdxf::trace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Event {
+        const char *name;
+        std::string detail;
+        Clock::time_point begin;
+        Clock::time_point end;
+    };
+
+    struct ThreadBuffer {
+        // The mutex is only contended while writing the trace output:
+        std::mutex mutex{};
+        unsigned int id{0};
+        std::string name{};
+        std::vector<Event> events{};
+    };
+
+    struct Registry {
+        // The buffers outlive their threads, e.g. the worker threads of
+        // a destroyed thread pool.
+        std::mutex mutex{};
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers{};
+        Clock::time_point start{Clock::now()};
+    };
+
+    static Registry &registry() {
+        static Registry instance{};
+        return instance;
+    }
+
+    static ThreadBuffer &thread_buffer() {
+        static thread_local std::shared_ptr<ThreadBuffer> buffer = []() {
+            auto &reg = registry();
+            auto new_buffer = std::make_shared<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            new_buffer->id = static_cast<unsigned int>(reg.buffers.size()) + 1;
+            reg.buffers.push_back(new_buffer);
+            return new_buffer;
+        }();
+        return *buffer;
+    }
+
+    namespace detail {
+        std::atomic<bool> enabled{false};
+
+        void record(const char *name, std::string detail,
+                    Clock::time_point begin, Clock::time_point end) {
+            auto &buffer = thread_buffer();
+            std::lock_guard<std::mutex> lock(buffer.mutex);
+            buffer.events.push_back(Event{name, std::move(detail), begin, end});
+        }
+    }
+
+    void start() {
+        auto &reg = registry();
+        {
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            for (auto &buffer : reg.buffers) {
+                std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+                buffer->events.clear();
+            }
+            reg.start = Clock::now();
+        }
+        detail::enabled = true;
+    }
+
+    void stop() {
+        detail::enabled = false;
+    }
+
+    std::size_t size() {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        std::size_t count = 0;
+        for (auto &buffer : reg.buffers) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            count += buffer->events.size();
+        }
+        return count;
+    }
+
+    void set_thread_name(const std::string &name) {
+        auto &buffer = thread_buffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.name = name;
+    }
+
+    static void write_json_string(std::ostream &stream, const std::string &s) {
+        static const char *kHexDigits = "0123456789abcdef";
+        stream << '"';
+        for (const char c : s) {
+            switch (c) {
+                case '"':
+                    stream << "\\\"";
+                    break;
+                case '\\':
+                    stream << "\\\\";
+                    break;
+                case '\n':
+                    stream << "\\n";
+                    break;
+                case '\r':
+                    stream << "\\r";
+                    break;
+                case '\t':
+                    stream << "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        stream << "\\u00" << kHexDigits[(c >> 4) & 0xF]
+                               << kHexDigits[c & 0xF];
+                    } else {
+                        stream << c;
+                    }
+            }
+        }
+        stream << '"';
+    }
+
+    static double microseconds(Clock::time_point start,
+                               Clock::time_point time) {
+        return std::chrono::duration<double, std::micro>(time - start).count();
+    }
+
+    void write_chrome_trace(std::ostream &stream) {
+        // Complete events ("ph": "X") and thread name metadata events, see
+        // "Trace Event Format" by the Chromium project.
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        auto const flags = stream.flags();
+        auto const precision = stream.precision();
+        stream << std::fixed << std::setprecision(3);
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        auto separator = [&stream, &first]() {
+            stream << (first ? "\n" : ",\n");
+            first = false;
+        };
+        for (auto &buffer : reg.buffers) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            if (buffer->events.empty()) continue;
+            if (!buffer->name.empty()) {
+                separator();
+                stream << R"({"ph":"M","name":"thread_name","pid":1,"tid":)"
+                       << buffer->id << R"(,"args":{"name":)";
+                write_json_string(stream, buffer->name);
+                stream << "}}";
+            }
+            for (auto const &event : buffer->events) {
+                separator();
+                stream << R"({"ph":"X","cat":"ezdxf","pid":1,"tid":)"
+                       << buffer->id << ",\"ts\":"
+                       << microseconds(reg.start, event.begin) << ",\"dur\":"
+                       << microseconds(event.begin, event.end)
+                       << ",\"name\":";
+                write_json_string(stream, event.name);
+                if (!event.detail.empty()) {
+                    stream << ",\"args\":{\"detail\":";
+                    write_json_string(stream, event.detail);
+                    stream << "}";
+                }
+                stream << "}";
+            }
+        }
+        stream << "\n]}\n";
+        stream.flags(flags);
+        stream.precision(precision);
+    }
+
+    bool write_chrome_trace(const std::string &filename) {
+        auto stream = std::ofstream(filename, std::ios::binary);
+        if (!stream) return false;
+        write_chrome_trace(stream);
+        return static_cast<bool>(stream);
+    }
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <algorithm>
+#include "ezdxf/type_index.hpp"
+
+namespace ezdxf {
+
+    void TypeIndex::clear() {
+        for (auto &entities : index_) entities.clear();
+        for (auto &removed : removed_) removed.clear();
+    }
+
+    void TypeIndex::add(Object *object) {
+        DXFType type = object->dxf_type();
+        if (type == DXFType::None) return;
+        auto const i = index(type);
+        // A removed entity can be added again:
+        if (!removed_[i].empty()) compact(i);
+        index_[i].push_back(object);
+    }
+
+    void TypeIndex::remove(Object *object) {
+        DXFType type = object->dxf_type();
+        if (type != DXFType::None) removed_[index(type)].push_back(object);
+    }
+
+    void TypeIndex::compact() {
+        for (std::size_t i = 0; i < kDXFTypeCount; ++i) {
+            if (!removed_[i].empty()) compact(i);
+        }
+    }
+
+    void TypeIndex::compact(const std::size_t type_index) const {
+        // Removes all collected entities in a single pass and preserves the
+        // order of the remaining entities.
+        auto &removed = removed_[type_index];
+        std::sort(removed.begin(), removed.end());
+        auto &entities = index_[type_index];
+        entities.erase(std::remove_if(
+                entities.begin(), entities.end(),
+                [&removed](Object *object) {
+                    return std::binary_search(removed.begin(), removed.end(),
+                                              object);
+                }), entities.end());
+        removed.clear();
+    }
+}
@@ -3,7 +3,10 @@
 //
 #include "ezdxf/utils.hpp"
 #include "ezdxf/tag/tag.hpp"
+#include <algorithm>
+#include <charconv>
 #include <stdexcept>
+#include <unordered_map>
 
 using namespace ezdxf::tag;
 
@@ -68,6 +71,17 @@ namespace ezdxf::utils {
         }
     }
 
+    std::optional<Handle> safe_str_to_handle(const String &s) {
+        // Returns an empty value for invalid handles, the "0" handle is a
+        // valid return value. The whole string has to be a hex number
+        // without sign, prefix or whitespace.
+        Handle handle = 0;
+        auto const last = s.data() + s.size();
+        auto const [end, ec] = std::from_chars(s.data(), last, handle, 16);
+        if (ec != std::errc() || end != last) return {};
+        return handle;
+    }
+
     inline static unsigned char _nibble_to_char(const unsigned char nibble) {
         // Convert a nibble (0-15) into a char '0'-'9', 'A'-'F'
         return nibble + (nibble < 10 ? 0x30 : 0x37); // '0' : 'A' - 10
@@ -89,6 +103,25 @@ namespace ezdxf::utils {
         return buffer;
     }
 
+    String handle_to_str(Handle h) {
+        // Convert a handle into a hex string without leading zeros,
+        // e.g. 0x1F to "1F"
+        char buffer[16];
+        int pos = 16;
+        do {
+            buffer[--pos] = static_cast<char>(_nibble_to_char(h & 0x0f));
+            h >>= 4;
+        } while (h);
+        return String(buffer + pos, 16 - pos);
+    }
+
+    String real_to_str(const Real value) {
+        char buffer[32];
+        auto const result = std::to_chars(buffer, buffer + sizeof(buffer),
+                                          value);
+        return String(buffer, result.ptr);
+    }
+
     inline static char _char_to_nibble(const char c) {
         // Convert an ascii hex char into a number e.g. 'A' -> 10.
         // Valid chars '0'-'9', 'A'-'F', 'a'-'f'
@@ -146,6 +179,15 @@ namespace ezdxf::utils {
         return merged;
     }
 
+    uint64_t fnv1a_hash(const char *data, std::size_t size, uint64_t seed) {
+        uint64_t hash = seed;
+        for (std::size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 0x100000001b3;  // FNV prime
+        }
+        return hash;
+    }
+
     String dxf_version_to_str(Version v) {
         switch (v) {
             case Version::R9:
@@ -199,4 +241,92 @@ namespace ezdxf::utils {
             Version::R2013,
             Version::R2018,
     };
+
+    String dxf_type_to_str(DXFType t) {
+        switch (t) {
+            case DXFType::Arc:
+                return "ARC";
+            case DXFType::AttDef:
+                return "ATTDEF";
+            case DXFType::Attrib:
+                return "ATTRIB";
+            case DXFType::Circle:
+                return "CIRCLE";
+            case DXFType::Dimension:
+                return "DIMENSION";
+            case DXFType::Ellipse:
+                return "ELLIPSE";
+            case DXFType::Face3d:
+                return "3DFACE";
+            case DXFType::Hatch:
+                return "HATCH";
+            case DXFType::Insert:
+                return "INSERT";
+            case DXFType::Line:
+                return "LINE";
+            case DXFType::LwPolyline:
+                return "LWPOLYLINE";
+            case DXFType::Mesh:
+                return "MESH";
+            case DXFType::MText:
+                return "MTEXT";
+            case DXFType::Point:
+                return "POINT";
+            case DXFType::Polyline:
+                return "POLYLINE";
+            case DXFType::Ray:
+                return "RAY";
+            case DXFType::SeqEnd:
+                return "SEQEND";
+            case DXFType::Solid:
+                return "SOLID";
+            case DXFType::Spline:
+                return "SPLINE";
+            case DXFType::Text:
+                return "TEXT";
+            case DXFType::Trace:
+                return "TRACE";
+            case DXFType::Vertex:
+                return "VERTEX";
+            case DXFType::Viewport:
+                return "VIEWPORT";
+            case DXFType::XLine:
+                return "XLINE";
+            default:
+                return "";
+        }
+    }
+
+    DXFType str_to_dxf_type(const String &s) {
+        // Hash lookup, because this function is called for each loaded
+        // DXF object:
+        static const std::unordered_map<String, DXFType> types{
+                {"ARC",        DXFType::Arc},
+                {"ATTDEF",     DXFType::AttDef},
+                {"ATTRIB",     DXFType::Attrib},
+                {"CIRCLE",     DXFType::Circle},
+                {"DIMENSION",  DXFType::Dimension},
+                {"ELLIPSE",    DXFType::Ellipse},
+                {"3DFACE",     DXFType::Face3d},
+                {"HATCH",      DXFType::Hatch},
+                {"INSERT",     DXFType::Insert},
+                {"LINE",       DXFType::Line},
+                {"LWPOLYLINE", DXFType::LwPolyline},
+                {"MESH",       DXFType::Mesh},
+                {"MTEXT",      DXFType::MText},
+                {"POINT",      DXFType::Point},
+                {"POLYLINE",   DXFType::Polyline},
+                {"RAY",        DXFType::Ray},
+                {"SEQEND",     DXFType::SeqEnd},
+                {"SOLID",      DXFType::Solid},
+                {"SPLINE",     DXFType::Spline},
+                {"TEXT",       DXFType::Text},
+                {"TRACE",      DXFType::Trace},
+                {"VERTEX",     DXFType::Vertex},
+                {"VIEWPORT",   DXFType::Viewport},
+                {"XLINE",      DXFType::XLine},
+        };
+        auto it = types.find(s);
+        return it != types.end() ? it->second : DXFType::None;
+    }
 }
@@ -63,4 +63,53 @@ TEST_CASE("Test BasicLoader() loading from strings.", "[tag][BasicLoader]") {
         REQUIRE(tag.group_code() == 2);
         REQUIRE(tag.string() == " ");
     }
-}
\ No newline at end of file
+
+    SECTION("Test byte offsets of tags.") {
+        auto reader = ezdxf::tag::BasicLoader(
+                " 0\r\nSECTION\r\n999\nxxx\n0\nEOF\n");
+        REQUIRE(reader.get_offset() == 0);
+        reader.get();
+        // Skipped comments are located in front of the current tag:
+        REQUIRE(reader.get_offset() == 21);
+        reader.get();
+        REQUIRE(reader.is_empty());
+        REQUIRE(reader.get_offset() == 27);
+    }
+}
+
+TEST_CASE("Test AscLoader() typed vector tags.", "[tag][AscLoader]") {
+    using ezdxf::tag::TagType;
+
+    SECTION("Test 3D vector.") {
+        auto basic_loader = ezdxf::tag::BasicLoader(
+                "10\n1\n20\n2\n30\n3\n0\nEOF\n");
+        auto loader = ezdxf::tag::AscLoader(basic_loader);
+        auto tag = loader.vec3_tag();
+        REQUIRE(tag->type() == TagType::kVec3);
+        REQUIRE(tag->vec3().x() == 1.0);
+        REQUIRE(tag->vec3().y() == 2.0);
+        REQUIRE(tag->vec3().z() == 3.0);
+        REQUIRE(loader.peek().equals(0, "EOF"));
+    }
+
+    SECTION("Test 2D vector.") {
+        auto basic_loader = ezdxf::tag::BasicLoader(
+                "11\n1\n21\n2\n0\nEOF\n");
+        auto loader = ezdxf::tag::AscLoader(basic_loader);
+        auto tag = loader.vec3_tag();
+        REQUIRE(tag->type() == TagType::kVec2);
+        REQUIRE(tag->vec3().y() == 2.0);
+        REQUIRE(loader.peek().equals(0, "EOF"));
+    }
+
+    SECTION("Test unordered vector returns the x-axis as real tag.") {
+        auto basic_loader = ezdxf::tag::BasicLoader(
+                "10\n1\n30\n3\n0\nEOF\n");
+        auto loader = ezdxf::tag::AscLoader(basic_loader);
+        auto tag = loader.vec3_tag();
+        REQUIRE(tag->type() == TagType::kReal);
+        REQUIRE(tag->real() == 1.0);
+        // The following tag is not consumed:
+        REQUIRE(loader.peek().group_code() == 30);
+    }
+}
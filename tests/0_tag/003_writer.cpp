@@ -0,0 +1,40 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <sstream>
+#include "ezdxf/tag/writer.hpp"
+#include "ezdxf/utils.hpp"
+
+using ezdxf::tag::AscWriter;
+using ezdxf::tag::StringTag;
+
+TEST_CASE("Test AscWriter().", "[tag][AscWriter]") {
+    auto stream = std::ostringstream{};
+    auto writer = AscWriter(stream);
+
+    SECTION("Group codes are right aligned.") {
+        writer.write(0, "SECTION");
+        writer.write(10, "1.0");
+        writer.write(1071, "1");
+        REQUIRE(stream.str() == "  0\nSECTION\n 10\n1.0\n1071\n1\n");
+    }
+
+    SECTION("Write string tags.") {
+        writer.write(StringTag(1, " text "));
+        REQUIRE(stream.str() == "  1\n text \n");
+    }
+
+    SECTION("Write handles as uppercase hex strings.") {
+        writer.write_handle(5, 0x1F);
+        writer.write_handle(330, 0);
+        REQUIRE(stream.str() == "  5\n1F\n330\n0\n");
+    }
+}
+
+TEST_CASE("Test handle_to_str().", "[utils][handle]") {
+    using ezdxf::utils::handle_to_str;
+    REQUIRE(handle_to_str(0) == "0");
+    REQUIRE(handle_to_str(0xABCDEF) == "ABCDEF");
+    REQUIRE(handle_to_str(0xFFFFFFFFFFFFFFFF) == "FFFFFFFFFFFFFFFF");
+}
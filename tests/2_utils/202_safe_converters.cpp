@@ -123,3 +123,21 @@ TEST_CASE("Test INVALID int64 converted by safe_str_to_int64()",
     }
 
 }
+
+TEST_CASE("Test handles converted by safe_str_to_handle()",
+          "[utils][safe]") {
+
+    SECTION("Test valid hex strings") {
+        REQUIRE(safe_str_to_handle("0").value() == 0);
+        REQUIRE(safe_str_to_handle("1F").value() == 0x1F);
+        REQUIRE(safe_str_to_handle("1f").value() == 0x1F);
+        REQUIRE(safe_str_to_handle("FFFFFFFFFFFFFFFF").value() ==
+                0xFFFFFFFFFFFFFFFF);
+    }
+
+    SECTION("Test invalid hex strings") {
+        std::string s = GENERATE("", "X", "#1F", "10000000000000000",
+                                 " 1F", "1F ", "0x1F", "-1", "+1", "1FZ");
+        REQUIRE(safe_str_to_handle(s).has_value() == false);
+    }
+}
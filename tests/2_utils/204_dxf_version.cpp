@@ -27,4 +27,28 @@ TEST_CASE("Test DXF version.", "[utils][version]") {
         REQUIRE(DXFExportVersions.has(Version::R12) == true);
         REQUIRE(DXFExportVersions.has(Version::R2018) == true);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test DXF type.", "[utils][type]") {
+    using ezdxf::DXFType;
+
+    SECTION("Test string to DXF type") {
+        REQUIRE(str_to_dxf_type("LINE") == DXFType::Line);
+        REQUIRE(str_to_dxf_type("3DFACE") == DXFType::Face3d);
+        // Unsupported DXF types:
+        REQUIRE(str_to_dxf_type("DICTIONARY") == DXFType::None);
+        REQUIRE(str_to_dxf_type("line") == DXFType::None);
+    }
+
+    SECTION("Test DXF type to string") {
+        REQUIRE(dxf_type_to_str(DXFType::LwPolyline) == "LWPOLYLINE");
+        REQUIRE(dxf_type_to_str(DXFType::None).empty());
+    }
+
+    SECTION("Test round trip of all DXF types") {
+        for (std::size_t i = 1; i < ezdxf::kDXFTypeCount; ++i) {
+            auto type = static_cast<DXFType>(i);
+            REQUIRE(str_to_dxf_type(dxf_type_to_str(type)) == type);
+        }
+    }
+}
@@ -1,3 +1,150 @@
 // Copyright (c) 2021, Manfred Moitzi
 // License: MIT License
 //
+#include <catch2/catch.hpp>
+#include "ezdxf/object_table.hpp"
+
+using ezdxf::acdb::Object;
+
+TEST_CASE("Testing ezdxf::ObjectTable", "[object_table]") {
+    auto table = ezdxf::ObjectTable<4>{};
+
+    SECTION("Test empty table.") {
+        REQUIRE(table.size() == 0);
+        REQUIRE(table.has(1) == false);
+        REQUIRE(table.get(1) == nullptr);
+        REQUIRE(table.begin() == table.end());
+    }
+
+    SECTION("Store and get objects.") {
+        auto ptr = table.store(std::make_unique<Object>(1));
+        REQUIRE(table.size() == 1);
+        REQUIRE(table.has(1) == true);
+        REQUIRE(table.get(1) == ptr);
+        REQUIRE(table.contains(ptr) == true);
+    }
+
+    SECTION("Handles with the same hash are stored in the same bucket.") {
+        // 4 bits for hashing: handle 0x11 and 0x21 are in the same bucket
+        auto p1 = table.store(std::make_unique<Object>(0x11));
+        auto p2 = table.store(std::make_unique<Object>(0x21));
+        REQUIRE(table.get(0x11) == p1);
+        REQUIRE(table.get(0x21) == p2);
+        REQUIRE(table.get(0x31) == nullptr);
+    }
+
+    SECTION("Handle 0 is invalid.") {
+        REQUIRE_THROWS_AS(table.store(std::make_unique<Object>()),
+                          std::invalid_argument);
+        REQUIRE(table.has(0) == false);
+    }
+
+    SECTION("Can not store the same handle twice.") {
+        table.store(std::make_unique<Object>(1));
+        REQUIRE_THROWS_AS(table.store(std::make_unique<Object>(1)),
+                          std::invalid_argument);
+    }
+
+    SECTION("Aquire a free handle.") {
+        table.store(std::make_unique<Object>(0xFF));
+        REQUIRE(table.aquire_free_handle() == 0x100);
+        REQUIRE(table.aquire_free_handle() == 0x101);
+    }
+
+    SECTION("Iterate objects in order of insertion.") {
+        for (ezdxf::Handle h : {5, 3, 0x13, 1}) {
+            table.store(std::make_unique<Object>(h));
+        }
+        auto handles = std::vector<ezdxf::Handle>{};
+        for (auto const object: table) {
+            handles.push_back(object->get_handle());
+        }
+        REQUIRE(handles == std::vector<ezdxf::Handle>{5, 3, 0x13, 1});
+        REQUIRE(table.at(2)->get_handle() == 0x13);
+    }
+}
+
+TEST_CASE("Erase and purge objects of ezdxf::ObjectTable",
+          "[object_table][purge]") {
+    auto table = ezdxf::ObjectTable<4>{};
+    // More than 64 objects to test multiple words of the erased bitmap:
+    for (ezdxf::Handle h = 1; h <= 100; ++h) {
+        table.store(std::make_unique<Object>(h));
+    }
+    auto alive_handles = [&table]() {
+        auto handles = std::vector<ezdxf::Handle>{};
+        table.for_each_alive([&handles](Object *object) {
+            handles.push_back(object->get_handle());
+        });
+        return handles;
+    };
+
+    SECTION("Iterate all objects.") {
+        REQUIRE(alive_handles().size() == 100);
+        REQUIRE(table.alive_count() == 100);
+    }
+
+    SECTION("Erase objects.") {
+        REQUIRE(table.erase(1) == true);
+        REQUIRE(table.erase(65) == true);
+        REQUIRE(table.erase(100) == true);
+        REQUIRE(table.erase(100) == true);  // erase twice
+        REQUIRE(table.erase(101) == false);  // does not exist
+        REQUIRE(table.get(65)->is_erased() == true);
+        REQUIRE(table.alive_count() == 97);
+        auto handles = alive_handles();
+        REQUIRE(handles.size() == 97);
+        REQUIRE(handles.front() == 2);
+        REQUIRE(handles[62] == 64);
+        REQUIRE(handles[63] == 66);
+        REQUIRE(handles.back() == 99);
+        // Erased objects are not destroyed:
+        REQUIRE(table.size() == 100);
+    }
+
+    SECTION("Object::erase() updates the erased bitmap.") {
+        auto const revision = table.revision();
+        table.get(64)->erase();
+        REQUIRE(table.revision() != revision);
+        REQUIRE(table.alive_count() == 99);
+        REQUIRE(alive_handles()[63] == 65);
+        auto erased = std::vector<ezdxf::Handle>{};
+        table.for_each_erased([&erased](Object *object) {
+            erased.push_back(object->get_handle());
+        });
+        REQUIRE(erased == std::vector<ezdxf::Handle>{64});
+        // Erasing twice does not change the table:
+        table.get(64)->erase();
+        REQUIRE(table.alive_count() == 99);
+    }
+
+    SECTION("Skip a full word of erased objects.") {
+        for (ezdxf::Handle h = 1; h <= 64; ++h) table.erase(h);
+        auto handles = alive_handles();
+        REQUIRE(handles.size() == 36);
+        REQUIRE(handles.front() == 65);
+    }
+
+    SECTION("Purge erased objects.") {
+        table.erase(2);
+        table.erase(70);
+        table.get(3)->erase();  // notifies the erased bitmap
+        REQUIRE(table.alive_count() == 97);
+        REQUIRE(table.purge() == 3);
+        REQUIRE(table.size() == 97);
+        REQUIRE(table.alive_count() == 97);
+        REQUIRE(table.has(2) == false);
+        REQUIRE(table.has(3) == false);
+        REQUIRE(table.at(1)->get_handle() == 4);
+        // Erased bitmap is still valid after purging:
+        table.erase(100);
+        REQUIRE(alive_handles().back() == 99);
+        // Handles are not reused:
+        REQUIRE(table.aquire_free_handle() == 101);
+    }
+
+    SECTION("Purge without erased objects.") {
+        REQUIRE(table.purge() == 0);
+        REQUIRE(table.size() == 100);
+    }
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include "ezdxf/resolver.hpp"
+
+using ezdxf::acdb::Object;
+
+TEST_CASE("Resolve owner handles and pointer references.",
+          "[object_table][resolver]") {
+    auto table = ezdxf::ObjectTable<>{};
+    auto owner = table.store(std::make_unique<Object>(1));
+    auto child = table.store(std::make_unique<Object>(2, 1));
+
+    SECTION("Resolve owner handle.") {
+        REQUIRE(child->get_owner_object() == nullptr);
+        auto errors = ezdxf::resolve_references(table);
+        REQUIRE(errors.empty());
+        REQUIRE(child->get_owner_object() == owner);
+        // Object without owner:
+        REQUIRE(owner->get_owner_object() == nullptr);
+    }
+
+    SECTION("Changing the owner handle invalidates the resolved owner.") {
+        ezdxf::resolve_references(table);
+        child->set_owner(3);
+        REQUIRE(child->get_owner_object() == nullptr);
+    }
+
+    SECTION("Resolve pointer references.") {
+        child->add_reference(340, 1);
+        child->add_reference(360, 0);  // "0" handle is no reference
+        auto errors = ezdxf::resolve_references(table);
+        REQUIRE(errors.empty());
+        auto const &refs = child->get_references();
+        REQUIRE(refs[0].object == owner);
+        REQUIRE(refs[1].object == nullptr);
+    }
+
+    SECTION("Invalid pointer group codes are rejected.") {
+        REQUIRE_THROWS_AS(child->add_reference(5, 1), std::invalid_argument);
+        REQUIRE_THROWS_AS(child->add_reference(370, 1),
+                          std::invalid_argument);
+    }
+
+    SECTION("Record dangling references as audit findings.") {
+        table.store(std::make_unique<Object>(3, 0xFE));
+        child->add_reference(350, 0xFF);
+        auto errors = ezdxf::resolve_references(table);
+        REQUIRE(errors.size() == 2);
+        REQUIRE(errors[0].code == ezdxf::ErrorCode::kDanglingPointerHandle);
+        REQUIRE(errors[0].message ==
+                "Dangling pointer handle #FF in object #2 (group code 350)");
+        REQUIRE(errors[1].code == ezdxf::ErrorCode::kDanglingOwnerHandle);
+        REQUIRE(errors[1].message ==
+                "Dangling owner handle #FE in object #3");
+    }
+}
+
+TEST_CASE("Resolve references of a big table in parallel.",
+          "[object_table][resolver]") {
+    auto table = ezdxf::ObjectTable<>{};
+    const ezdxf::Handle count = 10 * ezdxf::kMinResolverChunkSize;
+    for (ezdxf::Handle h = 1; h <= count; ++h) {
+        // Each object is owned by its predecessor, the first object has a
+        // dangling owner and every 1000th object a dangling pointer:
+        auto object = std::make_unique<Object>(h, h == 1 ? count + 1 : h - 1);
+        if (h % 1000 == 0) object->add_reference(340, count + h);
+        table.store(std::move(object));
+    }
+    auto pool = ezdxf::ThreadPool(4);
+    auto errors = ezdxf::resolve_references(table, pool);
+    REQUIRE(errors.size() == 1 + count / 1000);
+    // Audit findings are in table order:
+    REQUIRE(errors[0].code == ezdxf::ErrorCode::kDanglingOwnerHandle);
+    REQUIRE(errors[1].code == ezdxf::ErrorCode::kDanglingPointerHandle);
+    REQUIRE(errors[1].message.find("in object #3E8") != std::string::npos);
+    for (ezdxf::Handle h = 2; h <= count; ++h) {
+        auto object = table.get(h);
+        REQUIRE(object->get_owner_object() == table.get(h - 1));
+    }
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include "ezdxf/owner_index.hpp"
+
+using ezdxf::acdb::Object;
+using ezdxf::Handle;
+
+static std::vector<Handle> handles(const ezdxf::Children &children) {
+    auto result = std::vector<Handle>{};
+    for (auto const object : children) result.push_back(object->get_handle());
+    return result;
+}
+
+TEST_CASE("Testing ezdxf::OwnerIndex", "[object_table][owner_index]") {
+    auto table = ezdxf::ObjectTable<>{};
+    table.store(std::make_unique<Object>(1));
+    table.store(std::make_unique<Object>(2));
+    table.store(std::make_unique<Object>(3, 1));
+    table.store(std::make_unique<Object>(4, 2));
+    table.store(std::make_unique<Object>(5, 1));
+    table.store(std::make_unique<Object>(6, 1));
+    auto index = ezdxf::OwnerIndex{};
+    index.build(table);
+
+    SECTION("Get children in order of insertion.") {
+        REQUIRE(handles(index.children(1)) == std::vector<Handle>{3, 5, 6});
+        REQUIRE(handles(index.children(2)) == std::vector<Handle>{4});
+        REQUIRE(index.count(1) == 3);
+        REQUIRE(index.owner_count() == 2);
+    }
+
+    SECTION("Objects without children.") {
+        REQUIRE(index.children(3).empty());
+        REQUIRE(index.children(3).begin() == index.children(3).end());
+        // Objects without owner are not indexed:
+        REQUIRE(index.children(0).empty());
+    }
+
+    SECTION("Add objects to existing owners.") {
+        index.add(table.store(std::make_unique<Object>(7, 2)));
+        index.add(table.store(std::make_unique<Object>(8, 1)));
+        REQUIRE(handles(index.children(1)) ==
+                std::vector<Handle>{3, 5, 6, 8});
+        REQUIRE(handles(index.children(2)) == std::vector<Handle>{4, 7});
+        REQUIRE(index.owner_count() == 2);
+    }
+
+    SECTION("Add objects to new owners.") {
+        index.add(table.store(std::make_unique<Object>(7, 3)));
+        REQUIRE(handles(index.children(3)) == std::vector<Handle>{7});
+        REQUIRE(index.owner_count() == 3);
+    }
+
+    SECTION("Rebuild index including added objects.") {
+        index.add(table.store(std::make_unique<Object>(7, 3)));
+        index.build(table);
+        REQUIRE(handles(index.children(3)) == std::vector<Handle>{7});
+        REQUIRE(handles(index.children(1)) == std::vector<Handle>{3, 5, 6});
+        REQUIRE(index.owner_count() == 3);
+    }
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include "ezdxf/type_index.hpp"
+#include "ezdxf/acdb/entity.hpp"
+
+using ezdxf::DXFType;
+using ezdxf::acdb::Entity;
+using ezdxf::acdb::Object;
+
+TEST_CASE("Testing ezdxf::TypeIndex", "[object_table][type_index]") {
+    auto table = ezdxf::ObjectTable<>{};
+    auto add = [&table](ezdxf::Handle handle, DXFType type) {
+        auto entity = std::make_unique<Entity>(type, "");
+        entity->set_handle(handle);
+        return table.store(std::move(entity));
+    };
+    auto line1 = add(1, DXFType::Line);
+    auto circle = add(2, DXFType::Circle);
+    auto line2 = add(3, DXFType::Line);
+    table.store(std::make_unique<Object>(4));
+    auto index = ezdxf::TypeIndex{};
+    index.build(table);
+
+    SECTION("Query entities by type in order of insertion.") {
+        REQUIRE(index.get(DXFType::Line) ==
+                std::vector<Object *>{line1, line2});
+        REQUIRE(index.get(DXFType::Circle) == std::vector<Object *>{circle});
+        REQUIRE(index.count(DXFType::Text) == 0);
+    }
+
+    SECTION("Objects of type None are not indexed.") {
+        REQUIRE(index.count(DXFType::None) == 0);
+    }
+
+    SECTION("Add and remove entities.") {
+        auto line3 = add(5, DXFType::Line);
+        index.add(line3);
+        index.remove(line1);
+        REQUIRE(index.get(DXFType::Line) ==
+                std::vector<Object *>{line2, line3});
+    }
+
+    SECTION("Remove many entities and add a removed entity again.") {
+        index.remove(line2);
+        index.remove(line1);
+        index.add(line1);
+        REQUIRE(index.get(DXFType::Line) == std::vector<Object *>{line1});
+    }
+}
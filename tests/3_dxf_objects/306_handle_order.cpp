@@ -0,0 +1,77 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <random>
+#include "ezdxf/object_table.hpp"
+
+using ezdxf::acdb::Object;
+using ezdxf::Handle;
+
+static std::vector<Handle> handles(const std::vector<Object *> &objects) {
+    auto result = std::vector<Handle>{};
+    for (auto const object : objects) result.push_back(object->get_handle());
+    return result;
+}
+
+TEST_CASE("Sort objects by handle.", "[object_table][handle_order]") {
+    auto storage = std::vector<std::unique_ptr<Object>>{};
+    auto objects = std::vector<Object *>{};
+    // Size of the test set, below and above the radix sort threshold:
+    const std::size_t size = GENERATE(0, 1, 10, 1000, 100000);
+    auto random = std::mt19937_64{size};
+    for (std::size_t i = 0; i < size; ++i) {
+        // Random handles use all byte positions:
+        Handle handle = random() | 1;
+        storage.push_back(std::make_unique<Object>(handle));
+        objects.push_back(storage.back().get());
+    }
+    auto expected = handles(objects);
+    std::sort(expected.begin(), expected.end());
+    ezdxf::sort_by_handle(objects);
+    REQUIRE(handles(objects) == expected);
+}
+
+TEST_CASE("Sort by handle is stable.", "[object_table][handle_order]") {
+    auto storage = std::vector<std::unique_ptr<Object>>{};
+    auto objects = std::vector<Object *>{};
+    for (std::size_t i = 0; i < 1000; ++i) {
+        storage.push_back(std::make_unique<Object>(1000 - i % 10));
+        objects.push_back(storage.back().get());
+    }
+    auto expected = objects;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const Object *a, const Object *b) {
+                         return a->get_handle() < b->get_handle();
+                     });
+    ezdxf::sort_by_handle(objects);
+    REQUIRE(objects == expected);
+}
+
+TEST_CASE("Cached handle order of the object table.",
+          "[object_table][handle_order]") {
+    auto table = ezdxf::ObjectTable<>{};
+    for (Handle h : {5, 0x300, 1, 0x20}) {
+        table.store(std::make_unique<Object>(h));
+    }
+    auto const &order = table.handle_order();
+    REQUIRE(handles(order) == std::vector<Handle>{1, 5, 0x20, 0x300});
+
+    SECTION("Order is cached until the table changes.") {
+        auto revision = table.revision();
+        REQUIRE(&table.handle_order() == &order);
+        REQUIRE(table.revision() == revision);
+    }
+
+    SECTION("Add objects.") {
+        table.store(std::make_unique<Object>(2));
+        REQUIRE(handles(table.handle_order()) ==
+                std::vector<Handle>{1, 2, 5, 0x20, 0x300});
+    }
+
+    SECTION("Erased objects are excluded.") {
+        table.erase(5);
+        REQUIRE(handles(table.handle_order()) ==
+                std::vector<Handle>{1, 0x20, 0x300});
+    }
+}
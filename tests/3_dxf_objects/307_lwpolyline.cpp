@@ -0,0 +1,140 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <sstream>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/acdb/factory.hpp"
+#include "ezdxf/acdb/lwpolyline.hpp"
+#include "ezdxf/tag/writer.hpp"
+
+using ezdxf::acdb::LwPolyline;
+
+static const char *kLwPolyline = "0\nLWPOLYLINE\n5\nA0\n330\n1F\n"
+                                 "100\nAcDbEntity\n8\nWALLS\n"
+                                 "100\nAcDbPolyline\n90\n3\n70\n1\n"
+                                 "10\n1.5\n20\n2\n"
+                                 "10\n3\n20\n4\n40\n0.5\n41\n0.25\n42\n1\n"
+                                 "10\n5\n20\n6\n"
+                                 "210\n0\n220\n0\n230\n1\n";
+
+static std::unique_ptr<ezdxf::acdb::Object>
+load(const char *data, ezdxf::ErrorMessages &errors) {
+    auto basic_loader = ezdxf::tag::BasicLoader(data);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    return ezdxf::acdb::load_object(loader, errors);
+}
+
+static std::string export_dxf(const ezdxf::acdb::Object &object) {
+    auto stream = std::ostringstream{};
+    auto writer = ezdxf::tag::AscWriter(stream);
+    object.export_dxf(writer);
+    return stream.str();
+}
+
+TEST_CASE("Load LWPOLYLINE vertices in bulk.", "[acdb][lwpolyline]") {
+    auto errors = ezdxf::ErrorMessages{};
+    auto object = load(kLwPolyline, errors);
+    auto polyline = dynamic_cast<LwPolyline *>(object.get());
+    REQUIRE(polyline != nullptr);
+    REQUIRE(errors.empty());
+    REQUIRE(polyline->dxf_type() == ezdxf::DXFType::LwPolyline);
+    REQUIRE(polyline->get_handle() == 0xA0);
+    REQUIRE(polyline->get_owner() == 0x1F);
+    REQUIRE(polyline->get_layer() == "WALLS");
+
+    REQUIRE(polyline->size() == 3);
+    REQUIRE(polyline->x() == std::vector<double>{1.5, 3.0, 5.0});
+    REQUIRE(polyline->y() == std::vector<double>{2.0, 4.0, 6.0});
+    REQUIRE(polyline->start_width() == std::vector<double>{0.0, 0.5, 0.0});
+    REQUIRE(polyline->end_width() == std::vector<double>{0.0, 0.25, 0.0});
+    REQUIRE(polyline->bulge() == std::vector<double>{0.0, 1.0, 0.0});
+    REQUIRE(polyline->identifiers().empty());
+    // The vertex tags are not stored as raw tags:
+    REQUIRE(polyline->find_raw_tag(10) == nullptr);
+    REQUIRE(polyline->find_raw_tag(210) != nullptr);
+}
+
+TEST_CASE("Export LWPOLYLINE vertices.", "[acdb][lwpolyline]") {
+    auto errors = ezdxf::ErrorMessages{};
+    auto object = load(kLwPolyline, errors);
+
+    SECTION("vertices are exported at the original position") {
+        REQUIRE(export_dxf(*object) ==
+                "  0\nLWPOLYLINE\n  5\nA0\n330\n1F\n"
+                "100\nAcDbEntity\n  8\nWALLS\n"
+                "100\nAcDbPolyline\n 90\n3\n 70\n1\n"
+                " 10\n1.5\n 20\n2\n"
+                " 10\n3\n 20\n4\n 40\n0.5\n 41\n0.25\n 42\n1\n"
+                " 10\n5\n 20\n6\n"
+                "210\n0\n220\n0\n230\n1\n");
+    }
+
+    SECTION("vertex count is updated") {
+        auto polyline = static_cast<LwPolyline *>(object.get());
+        polyline->append(7.0, 8.0);
+        auto const dxf = export_dxf(*object);
+        REQUIRE(dxf.find(" 90\n4\n") != std::string::npos);
+        REQUIRE(dxf.find(" 10\n7\n 20\n8\n210\n") != std::string::npos);
+    }
+}
+
+TEST_CASE("Load LWPOLYLINE from string tags.", "[acdb][lwpolyline]") {
+    auto errors = ezdxf::ErrorMessages{};
+    auto tags = ezdxf::tag::StringTags{};
+    tags.emplace_back(5, "A0");
+    tags.emplace_back(90, "2");
+    tags.emplace_back(10, "1");
+    tags.emplace_back(20, "2");
+    tags.emplace_back(91, "7");
+    tags.emplace_back(10, "3");
+    tags.emplace_back(20, "x");
+    tags.emplace_back(91, "8");
+    auto object = ezdxf::acdb::load_object("LWPOLYLINE", tags, errors, 1);
+    auto polyline = dynamic_cast<LwPolyline *>(object.get());
+    REQUIRE(polyline != nullptr);
+    REQUIRE(polyline->x() == std::vector<double>{1.0, 3.0});
+    // Invalid values are stored as 0:
+    REQUIRE(polyline->y() == std::vector<double>{2.0, 0.0});
+    REQUIRE(polyline->identifiers() == std::vector<int64_t>{7, 8});
+    // Optional arrays are not allocated for 0 values:
+    REQUIRE(polyline->start_width().empty());
+    REQUIRE(polyline->bulge().empty());
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].code == ezdxf::ErrorCode::kInvalidRealTag);
+    REQUIRE(polyline->get_raw_tags().size() == 2);
+}
+
+TEST_CASE("Export new LWPOLYLINE.", "[acdb][lwpolyline]") {
+    auto polyline = LwPolyline();
+    polyline.set_handle(0xA0);
+    polyline.append(1.0, 2.0);
+    polyline.append(3.0, 4.0, 0.0, 0.0, -0.5);
+    REQUIRE(polyline.bulge() == std::vector<double>{0.0, -0.5});
+    REQUIRE(polyline.end_width().empty());
+    REQUIRE(export_dxf(polyline) ==
+            "  0\nLWPOLYLINE\n  5\nA0\n"
+            "100\nAcDbEntity\n  8\n0\n"
+            "100\nAcDbPolyline\n 90\n2\n 70\n0\n"
+            " 10\n1\n 20\n2\n"
+            " 10\n3\n 20\n4\n 42\n-0.5\n");
+}
+
+TEST_CASE("LWPOLYLINE snapshot round trip.", "[acdb][lwpolyline]") {
+    auto const dxf = std::string("0\nSECTION\n2\nENTITIES\n") +
+                     kLwPolyline + "0\nENDSEC\n0\nEOF\n";
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(dxf);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    doc.load(loader);
+
+    auto stream = std::stringstream{};
+    REQUIRE(doc.save_snapshot(stream) == true);
+    auto restored = ezdxf::Document();
+    REQUIRE(restored.load_snapshot(stream) == true);
+    auto polyline = dynamic_cast<LwPolyline *>(restored.get(0xA0));
+    REQUIRE(polyline != nullptr);
+    REQUIRE(polyline->x() == std::vector<double>{1.5, 3.0, 5.0});
+    REQUIRE(polyline->bulge() == std::vector<double>{0.0, 1.0, 0.0});
+    REQUIRE(export_dxf(*polyline) == export_dxf(*doc.get(0xA0)));
+}
@@ -0,0 +1,249 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <sstream>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/acdb/polyline.hpp"
+#include "ezdxf/tag/writer.hpp"
+
+using ezdxf::DXFType;
+using ezdxf::LoadOptions;
+using ezdxf::acdb::Polyline;
+
+// The POLYLINE entity as exported by the AscWriter:
+static const char *kPolyline =
+        "  0\nPOLYLINE\n  5\nA0\n330\n1F\n100\nAcDbEntity\n  8\nWALLS\n"
+        "100\nAcDb2dPolyline\n 66\n1\n 70\n1\n"
+        "  0\nVERTEX\n  5\nA1\n330\nA0\n100\nAcDbEntity\n  8\nWALLS\n"
+        "100\nAcDbVertex\n100\nAcDb2dVertex\n"
+        " 10\n1.5\n 20\n2\n 30\n0\n 70\n0\n"
+        "  0\nVERTEX\n  5\nA2\n330\nA0\n100\nAcDbEntity\n  8\nWALLS\n"
+        "100\nAcDbVertex\n100\nAcDb2dVertex\n"
+        " 10\n3\n 20\n4\n 30\n0\n 40\n0.5\n 41\n0.25\n 42\n1\n 70\n0\n"
+        "  0\nVERTEX\n  5\nA3\n330\nA0\n100\nAcDbEntity\n  8\nDOORS\n"
+        "100\nAcDbVertex\n100\nAcDb2dVertex\n"
+        " 10\n5\n 20\n6\n 30\n0\n 70\n2\n 50\n45\n"
+        "  0\nSEQEND\n  5\nA4\n330\nA0\n100\nAcDbEntity\n  8\nWALLS\n";
+
+static std::string make_dxf(const char *entities) {
+    return std::string("0\nSECTION\n2\nENTITIES\n") + entities +
+           "0\nLINE\n5\nB0\n330\n1F\n8\nWALLS\n0\nENDSEC\n0\nEOF\n";
+}
+
+static ezdxf::Document load(const std::string &dxf,
+                            const LoadOptions &options = {}) {
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(dxf);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    doc.load(loader, options);
+    return doc;
+}
+
+static std::string export_dxf(const ezdxf::acdb::Object &object) {
+    auto stream = std::ostringstream{};
+    auto writer = ezdxf::tag::AscWriter(stream);
+    object.export_dxf(writer);
+    return stream.str();
+}
+
+TEST_CASE("Load POLYLINE with VERTEX and SEQEND.", "[acdb][polyline]") {
+    auto doc = load(make_dxf(kPolyline));
+    auto polyline = dynamic_cast<Polyline *>(doc.get(0xA0));
+    REQUIRE(polyline != nullptr);
+    // The owner #1F of the entities does not exist:
+    for (auto const &error : doc.get_errors())
+        REQUIRE(error.code == ezdxf::ErrorCode::kDanglingOwnerHandle);
+    // The VERTEX and SEQEND entities are not stored as objects:
+    REQUIRE(doc.get_object_table().size() == 2);
+    REQUIRE(doc.get(0xA1) == nullptr);
+    REQUIRE(doc.query(DXFType::Vertex).empty());
+    // but their handles are in use:
+    REQUIRE(doc.reserve_handles(1) > 0xB0);
+
+    REQUIRE(polyline->size() == 3);
+    REQUIRE(polyline->x() == std::vector<double>{1.5, 3.0, 5.0});
+    REQUIRE(polyline->y() == std::vector<double>{2.0, 4.0, 6.0});
+    REQUIRE(polyline->z() == std::vector<double>{0.0, 0.0, 0.0});
+    REQUIRE(polyline->start_width() == std::vector<double>{0.0, 0.5, 0.0});
+    REQUIRE(polyline->bulge() == std::vector<double>{0.0, 1.0, 0.0});
+    REQUIRE(polyline->vertex_flags() == std::vector<int32_t>{0, 0, 2});
+    REQUIRE(polyline->vertex_handles() ==
+            std::vector<ezdxf::Handle>{0xA1, 0xA2, 0xA3});
+    REQUIRE(polyline->has_seqend() == true);
+    REQUIRE(polyline->seqend_handle() == 0xA4);
+    REQUIRE(polyline->max_sequence_handle() == 0xA4);
+
+    SECTION("tags without decoded attribute are extra tags") {
+        auto const &extra = polyline->extra_tags();
+        REQUIRE(extra.size() == 2);
+        REQUIRE(extra[0].vertex == 2);
+        REQUIRE(extra[0].tag.equals(8, "DOORS"));
+        REQUIRE(extra[1].tag.equals(50, "45"));
+    }
+
+    SECTION("export rebuilds the VERTEX and SEQEND entities") {
+        REQUIRE(export_dxf(*polyline) == kPolyline);
+    }
+}
+
+TEST_CASE("Load DXF R12 POLYLINE.", "[acdb][polyline]") {
+    static const char *kR12 =
+            "  0\nPOLYLINE\n  8\n0\n 66\n1\n 70\n8\n"
+            "  0\nVERTEX\n  8\n0\n 10\n1\n 20\n2\n 30\n3\n 70\n32\n"
+            "  0\nVERTEX\n  8\n0\n 10\n4\n 20\n5\n 30\n6\n 70\n32\n"
+            "  0\nSEQEND\n  8\n0\n";
+    auto doc = load(make_dxf(kR12));
+    auto polylines = doc.query(DXFType::Polyline);
+    REQUIRE(polylines.size() == 1);
+    auto polyline = static_cast<Polyline *>(polylines[0]);
+    REQUIRE(polyline->z() == std::vector<double>{3.0, 6.0});
+    REQUIRE(polyline->vertex_handles() == std::vector<ezdxf::Handle>{0, 0});
+    // No handles, owner handles or subclass markers are added:
+    REQUIRE(export_dxf(*polyline) == kR12);
+}
+
+TEST_CASE("Load polyface mesh face records.", "[acdb][polyline]") {
+    static const char *kPolyface =
+            "0\nPOLYLINE\n5\nC0\n8\n0\n66\n1\n70\n64\n71\n3\n72\n1\n"
+            "0\nVERTEX\n5\nC1\n8\n0\n10\n0\n20\n0\n30\n0\n70\n192\n"
+            "0\nVERTEX\n5\nC2\n8\n0\n10\n1\n20\n0\n30\n0\n70\n192\n"
+            "0\nVERTEX\n5\nC3\n8\n0\n10\n1\n20\n1\n30\n0\n70\n192\n"
+            "0\nVERTEX\n5\nC4\n8\n0\n10\n0\n20\n0\n30\n0\n70\n128\n"
+            "71\n1\n72\n2\n73\n-3\n"
+            "0\nSEQEND\n5\nC5\n8\n0\n";
+    auto doc = load(make_dxf(kPolyface));
+    auto polyline = static_cast<Polyline *>(doc.get(0xC0));
+    REQUIRE(polyline->size() == 4);
+    REQUIRE(polyline->face_indices() ==
+            std::vector<int32_t>{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                 1, 2, -3, 0});
+}
+
+TEST_CASE("Skip POLYLINE sequence by selective loading.",
+          "[acdb][polyline]") {
+    SECTION("type filter") {
+        auto doc = load(make_dxf(kPolyline), LoadOptions{{DXFType::Line}});
+        REQUIRE(doc.get_object_table().size() == 1);
+        REQUIRE(doc.get_skipped_handles() ==
+                std::vector<ezdxf::Handle>{0xA0, 0xA1, 0xA2, 0xA3, 0xA4});
+    }
+
+    SECTION("layer filter") {
+        auto doc = load(make_dxf(kPolyline), LoadOptions{{}, {"DOORS"}});
+        REQUIRE(doc.get_object_table().size() == 0);
+        REQUIRE(doc.get_skipped_handles().size() == 6);
+    }
+
+    SECTION("layer filter accepts the POLYLINE") {
+        auto doc = load(make_dxf(kPolyline), LoadOptions{{}, {"WALLS"}});
+        REQUIRE(doc.get_object_table().size() == 2);
+        REQUIRE(static_cast<Polyline *>(doc.get(0xA0))->size() == 3);
+    }
+}
+
+TEST_CASE("POLYLINE lazy loading and snapshots.", "[acdb][polyline]") {
+    auto const dxf = make_dxf(kPolyline);
+    auto doc = load(dxf);
+    auto const expected = export_dxf(*doc.get(0xA0));
+
+    SECTION("lazy loading") {
+        auto lazy = ezdxf::Document();
+        REQUIRE(lazy.load_lazy(std::make_unique<std::istringstream>(
+                dxf, std::ios::binary)) == true);
+        REQUIRE(lazy.get(0xA1) == nullptr);
+        auto polyline = dynamic_cast<Polyline *>(lazy.get(0xA0));
+        REQUIRE(polyline != nullptr);
+        REQUIRE(export_dxf(*polyline) == expected);
+        REQUIRE(lazy.reserve_handles(1) > 0xB0);
+    }
+
+    SECTION("snapshot") {
+        auto stream = std::stringstream{};
+        REQUIRE(doc.save_snapshot(stream) == true);
+        auto restored = ezdxf::Document();
+        REQUIRE(restored.load_snapshot(stream) == true);
+        auto polyline = dynamic_cast<Polyline *>(restored.get(0xA0));
+        REQUIRE(polyline != nullptr);
+        REQUIRE(polyline->vertex_handles() == std::vector<ezdxf::Handle>{
+                0xA1, 0xA2, 0xA3});
+        REQUIRE(export_dxf(*polyline) == expected);
+    }
+}
+
+TEST_CASE("VERTEX application defined data.", "[acdb][polyline]") {
+    static const char *kAppData =
+            "  0\nPOLYLINE\n  5\nD0\n100\nAcDbEntity\n  8\n0\n"
+            "100\nAcDb2dPolyline\n 66\n1\n 70\n0\n"
+            "  0\nVERTEX\n  5\nD1\n102\n{ACAD_XDICTIONARY\n360\nB0\n102\n}\n"
+            "330\nD0\n100\nAcDbEntity\n  8\n0\n"
+            "100\nAcDbVertex\n100\nAcDb2dVertex\n"
+            " 10\n1\n 20\n2\n 30\n0\n 70\n0\n"
+            "  0\nSEQEND\n  5\nD2\n102\n{ACAD_REACTORS\n330\nB0\n102\n}\n"
+            "330\nD0\n100\nAcDbEntity\n  8\n0\n";
+    auto doc = load(make_dxf(kAppData));
+    // The owner #1F of the LINE does not exist:
+    for (auto const &error : doc.get_errors())
+        REQUIRE(error.code == ezdxf::ErrorCode::kDanglingOwnerHandle);
+    auto polyline = static_cast<Polyline *>(doc.get(0xD0));
+    REQUIRE(polyline->extra_tags().empty());
+    REQUIRE(polyline->app_data().size() == 3);
+
+    SECTION("is exported after the handle") {
+        REQUIRE(export_dxf(*polyline) == kAppData);
+    }
+
+    SECTION("pointer references are references of the POLYLINE") {
+        auto const &refs = polyline->get_references();
+        REQUIRE(refs.size() == 2);
+        REQUIRE(refs[0].code == 360);
+        REQUIRE(refs[0].object == doc.get(0xB0));
+        REQUIRE(refs[1].code == 330);
+        REQUIRE(refs[1].object == doc.get(0xB0));
+    }
+
+    SECTION("snapshot does not duplicate the references") {
+        auto stream = std::stringstream{};
+        REQUIRE(doc.save_snapshot(stream) == true);
+        auto restored = ezdxf::Document();
+        REQUIRE(restored.load_snapshot(stream) == true);
+        auto copy = static_cast<Polyline *>(restored.get(0xD0));
+        REQUIRE(copy->get_references().size() == 2);
+        REQUIRE(export_dxf(*copy) == kAppData);
+    }
+}
+
+TEST_CASE("Duplicate handles of VERTEX and SEQEND.", "[acdb][polyline]") {
+    auto const is_duplicate = [](const ezdxf::Document &doc) {
+        for (auto const &error : doc.get_errors()) {
+            if (error.code == ezdxf::ErrorCode::kDuplicateHandle) return true;
+        }
+        return false;
+    };
+
+    SECTION("later object reuses a VERTEX handle") {
+        auto doc = load(make_dxf(
+                (std::string(kPolyline) + "0\nPOINT\n5\nA2\n8\n0\n").c_str()));
+        REQUIRE(is_duplicate(doc));
+        REQUIRE(doc.get(0xA2) == nullptr);
+        REQUIRE(doc.query(DXFType::Point).empty());
+    }
+
+    SECTION("VERTEX reuses the handle of an object") {
+        auto doc = load(make_dxf(
+                (std::string("0\nPOINT\n5\nA3\n8\n0\n") + kPolyline).c_str()));
+        REQUIRE(is_duplicate(doc));
+        REQUIRE(doc.get(0xA0) == nullptr);
+        REQUIRE(doc.get(0xA3)->dxf_type() == DXFType::Point);
+    }
+
+    SECTION("VERTEX and SEQEND share a handle") {
+        static const char *kShared =
+                "0\nPOLYLINE\n5\nE0\n8\n0\n66\n1\n70\n0\n"
+                "0\nVERTEX\n5\nE1\n8\n0\n10\n0\n20\n0\n30\n0\n70\n0\n"
+                "0\nSEQEND\n5\nE1\n8\n0\n";
+        auto doc = load(make_dxf(kShared));
+        REQUIRE(is_duplicate(doc));
+        REQUIRE(doc.get(0xE0) == nullptr);
+    }
+}
@@ -0,0 +1,133 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <sstream>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/acdb/factory.hpp"
+#include "ezdxf/acdb/mesh.hpp"
+#include "ezdxf/tag/writer.hpp"
+
+using ezdxf::acdb::Mesh;
+
+// The MESH entity as exported by the AscWriter, the override data (90)
+// after the creases and the (92) tag in front of the AcDbSubDMesh
+// subclass are not data blocks:
+static const char *kMesh =
+        "  0\nMESH\n  5\nA0\n330\n1F\n100\nAcDbEntity\n  8\nWALLS\n"
+        " 92\n7\n100\nAcDbSubDMesh\n 71\n2\n 72\n0\n 91\n0\n"
+        " 92\n3\n 10\n0\n 20\n0\n 30\n0\n 10\n1\n 20\n0\n 30\n0\n"
+        " 10\n0.5\n 20\n1\n 30\n2\n"
+        " 93\n4\n 90\n3\n 90\n0\n 90\n1\n 90\n2\n"
+        " 94\n1\n 90\n0\n 90\n1\n"
+        " 95\n1\n140\n0.25\n"
+        " 90\n1\n 91\n0\n 92\n1\n 90\n5\n";
+
+static std::unique_ptr<ezdxf::acdb::Object>
+load(const char *data, ezdxf::ErrorMessages &errors) {
+    auto basic_loader = ezdxf::tag::BasicLoader(data);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    return ezdxf::acdb::load_object(loader, errors);
+}
+
+static std::string export_dxf(const ezdxf::acdb::Object &object) {
+    auto stream = std::ostringstream{};
+    auto writer = ezdxf::tag::AscWriter(stream);
+    object.export_dxf(writer);
+    return stream.str();
+}
+
+static void require_geometry(const Mesh &mesh) {
+    REQUIRE(mesh.vertex_count() == 3);
+    REQUIRE(std::vector<double>(mesh.vertices().begin(),
+                                mesh.vertices().end()) ==
+            std::vector<double>{0, 0, 0, 1, 0, 0, 0.5, 1, 2});
+    REQUIRE(std::vector<int32_t>(mesh.face_list().begin(),
+                                 mesh.face_list().end()) ==
+            std::vector<int32_t>{3, 0, 1, 2});
+    REQUIRE(std::vector<int32_t>(mesh.edges().begin(), mesh.edges().end()) ==
+            std::vector<int32_t>{0, 1});
+    REQUIRE(mesh.creases().size() == 1);
+    REQUIRE(mesh.creases()[0] == 0.25);
+}
+
+TEST_CASE("Load MESH data blocks in bulk.", "[acdb][mesh]") {
+    auto errors = ezdxf::ErrorMessages{};
+    auto object = load(kMesh, errors);
+    auto mesh = dynamic_cast<Mesh *>(object.get());
+    REQUIRE(mesh != nullptr);
+    REQUIRE(errors.empty());
+    REQUIRE(mesh->dxf_type() == ezdxf::DXFType::Mesh);
+    REQUIRE(mesh->get_handle() == 0xA0);
+    REQUIRE(mesh->get_layer() == "WALLS");
+    require_geometry(*mesh);
+    // The data blocks are not stored as raw tags:
+    REQUIRE(mesh->find_raw_tag(10) == nullptr);
+    REQUIRE(mesh->find_raw_tag(140) == nullptr);
+
+    SECTION("export rebuilds the data blocks at their location") {
+        REQUIRE(export_dxf(*mesh) == kMesh);
+    }
+}
+
+TEST_CASE("Load MESH from loaded tags.", "[acdb][mesh]") {
+    auto basic_loader = ezdxf::tag::BasicLoader(kMesh);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    loader.skip();  // (0, MESH)
+    auto tags = ezdxf::tag::StringTags{};
+    while (!loader.eof()) tags.push_back(loader.get());
+    auto errors = ezdxf::ErrorMessages{};
+    auto object = ezdxf::acdb::load_object("MESH", tags, errors, 1);
+    auto mesh = dynamic_cast<Mesh *>(object.get());
+    REQUIRE(mesh != nullptr);
+    REQUIRE(errors.empty());
+    require_geometry(*mesh);
+    REQUIRE(export_dxf(*mesh) == kMesh);
+}
+
+TEST_CASE("Invalid MESH values.", "[acdb][mesh]") {
+    auto errors = ezdxf::ErrorMessages{};
+    auto object = load("0\nMESH\n100\nAcDbSubDMesh\n"
+                       "92\n1\n10\nX\n20\n1\n30\n1\n93\n-5\n90\n3\n", errors);
+    auto mesh = static_cast<Mesh *>(object.get());
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].code == ezdxf::ErrorCode::kInvalidRealTag);
+    REQUIRE(mesh->vertex_count() == 1);
+    REQUIRE(mesh->vertices()[0] == 0.0);
+    // A negative count does not consume any values:
+    REQUIRE(mesh->face_list().empty());
+    REQUIRE(mesh->find_raw_tag(90) != nullptr);
+}
+
+TEST_CASE("Export new MESH.", "[acdb][mesh]") {
+    auto mesh = Mesh();
+    mesh.append_vertex(0, 0, 0);
+    mesh.append_vertex(1, 0, 0);
+    mesh.append_vertex(1, 1, 0);
+    auto const face = std::vector<int32_t>{0, 1, 2};
+    mesh.append_face(ezdxf::Span(face));
+    REQUIRE(export_dxf(mesh) ==
+            "  0\nMESH\n  5\n0\n100\nAcDbEntity\n  8\n0\n"
+            "100\nAcDbSubDMesh\n 71\n2\n 72\n0\n 91\n0\n"
+            " 92\n3\n 10\n0\n 20\n0\n 30\n0\n 10\n1\n 20\n0\n 30\n0\n"
+            " 10\n1\n 20\n1\n 30\n0\n"
+            " 93\n4\n 90\n3\n 90\n0\n 90\n1\n 90\n2\n"
+            " 94\n0\n 95\n0\n");
+}
+
+TEST_CASE("MESH snapshot.", "[acdb][mesh]") {
+    auto const dxf = std::string("0\nSECTION\n2\nENTITIES\n") + kMesh +
+                     "0\nENDSEC\n0\nEOF\n";
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(dxf);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    doc.load(loader);
+    auto stream = std::stringstream{};
+    REQUIRE(doc.save_snapshot(stream) == true);
+    auto restored = ezdxf::Document();
+    REQUIRE(restored.load_snapshot(stream) == true);
+    auto mesh = dynamic_cast<Mesh *>(restored.get(0xA0));
+    REQUIRE(mesh != nullptr);
+    require_geometry(*mesh);
+    REQUIRE(export_dxf(*mesh) == kMesh);
+}
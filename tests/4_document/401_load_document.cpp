@@ -0,0 +1,274 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/acdb/entity.hpp"
+
+using ezdxf::DXFType;
+using ezdxf::acdb::Entity;
+
+static const char *kDXF = R"(  0
+SECTION
+  2
+HEADER
+  9
+$ACADVER
+  1
+AC1024
+  0
+ENDSEC
+  0
+SECTION
+  2
+TABLES
+  0
+TABLE
+  2
+BLOCK_RECORD
+  5
+1
+330
+0
+  0
+BLOCK_RECORD
+  5
+1F
+330
+1
+  2
+*Model_Space
+  0
+BLOCK_RECORD
+  5
+1E
+330
+1
+  2
+*Paper_Space
+  0
+ENDTAB
+  0
+ENDSEC
+  0
+SECTION
+  2
+ENTITIES
+  0
+LINE
+  5
+100
+330
+1F
+  8
+Lines
+ 10
+0.0
+ 20
+0.0
+ 11
+1.0
+ 21
+1.0
+  0
+CIRCLE
+  5
+101
+102
+{ACAD_REACTORS
+330
+200
+102
+}
+330
+1F
+  8
+Circles
+ 10
+0.0
+ 20
+0.0
+ 40
+1.0
+  0
+CIRCLE
+  5
+102
+330
+1E
+  8
+Circles
+ 10
+0.0
+ 20
+0.0
+ 40
+2.0
+  0
+ENDSEC
+  0
+SECTION
+  2
+OBJECTS
+  0
+DICTIONARY
+  5
+200
+330
+0
+350
+1F
+  0
+ENDSEC
+  0
+EOF
+)";
+
+static ezdxf::Document load_document(const std::string &s) {
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(s);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    REQUIRE(doc.load(loader) == true);
+    return doc;
+}
+
+TEST_CASE("Load DXF document.", "[document][load]") {
+    auto doc = load_document(kDXF);
+
+    SECTION("Load sections in file order.") {
+        auto const &sections = doc.get_sections();
+        REQUIRE(sections.size() == 4);
+        REQUIRE(sections[0].name == "HEADER");
+        REQUIRE(sections[0].tags.size() == 2);
+        REQUIRE(sections[1].name == "TABLES");
+        // TABLE, 2x BLOCK_RECORD, ENDTAB
+        REQUIRE(sections[1].objects.size() == 4);
+        REQUIRE(sections[2].name == "ENTITIES");
+        REQUIRE(sections[2].objects.size() == 3);
+        REQUIRE(sections[3].name == "OBJECTS");
+    }
+
+    SECTION("Objects without handle get a new handle.") {
+        auto endtab = doc.get_sections()[1].objects[3];
+        REQUIRE(endtab->get_handle() == 0x201);
+        REQUIRE(doc.get(0x201) == endtab);
+    }
+
+    SECTION("Load handles, owners and layers.") {
+        auto line = dynamic_cast<Entity *>(doc.get(0x100));
+        REQUIRE(line != nullptr);
+        REQUIRE(line->dxf_type() == DXFType::Line);
+        REQUIRE(line->get_owner() == 0x1F);
+        REQUIRE(line->get_layer() == "Lines");
+        REQUIRE(line->get_raw_tags().size() == 7);
+    }
+
+    SECTION("Resolve owner and pointer references.") {
+        auto circle = doc.get(0x101);
+        REQUIRE(circle->get_owner_object() == doc.get(0x1F));
+        // The reactor is a pointer reference and not the owner:
+        REQUIRE(circle->get_references().size() == 1);
+        REQUIRE(circle->get_references()[0].object == doc.get(0x200));
+        REQUIRE(doc.get_errors().empty());
+    }
+
+    SECTION("Find modelspace.") {
+        REQUIRE(doc.get_modelspace_handle() == 0x1F);
+        REQUIRE(doc.children(0x1F).size() == 2);
+    }
+
+    SECTION("Query entities by type.") {
+        auto const &circles = doc.query(DXFType::Circle);
+        REQUIRE(circles.size() == 2);
+        // All circles in modelspace:
+        auto msp = doc.get_modelspace_handle();
+        auto count = std::count_if(
+                circles.begin(), circles.end(),
+                [msp](auto e) { return e->get_owner() == msp; });
+        REQUIRE(count == 1);
+    }
+
+    SECTION("Add and erase entities.") {
+        auto circle = std::make_unique<Entity>(DXFType::Circle, "CIRCLE");
+        circle->set_owner(0x1F);
+        auto ptr = doc.add(std::move(circle));
+        REQUIRE(ptr->get_handle() == 0x202);
+        REQUIRE(ptr->get_owner_object() == doc.get(0x1F));
+        REQUIRE(doc.query(DXFType::Circle).size() == 3);
+        REQUIRE(doc.children(0x1F).size() == 3);
+        REQUIRE(doc.get_sections()[2].objects.back() == ptr);
+
+        doc.erase(doc.get(0x101));
+        REQUIRE(doc.query(DXFType::Circle).size() == 2);
+        REQUIRE(doc.get(0x101)->is_alive() == false);
+    }
+
+    SECTION("Purge erased entities.") {
+        doc.erase(doc.get(0x100));
+        REQUIRE(doc.purge() == 1);
+        REQUIRE(doc.get(0x100) == nullptr);
+        REQUIRE(doc.get_sections()[2].objects.size() == 2);
+        REQUIRE(doc.children(0x1F).size() == 1);
+        REQUIRE(doc.query(DXFType::Line).empty());
+        REQUIRE(doc.get_errors().empty());
+    }
+
+    SECTION("Purging creates dangling references.") {
+        // The circle 0x101 references the dictionary 0x200 as reactor:
+        doc.erase(doc.get(0x200));
+        doc.purge();
+        REQUIRE(doc.get(0x101)->get_references()[0].object == nullptr);
+        REQUIRE(doc.get_errors().size() == 1);
+        REQUIRE(doc.get_errors()[0].code ==
+                ezdxf::ErrorCode::kDanglingPointerHandle);
+    }
+}
+
+TEST_CASE("Purging does not repeat audit findings.", "[document][load]") {
+    auto doc = load_document(
+            "0\nSECTION\n2\nENTITIES\n0\nLINE\n5\n100\n330\n1F\n"
+            "0\nLINE\n5\n101\n330\n100\n0\nLINE\n5\n102\n"
+            "0\nENDSEC\n0\nEOF\n");
+    // The owner #1F of the LINE #100 does not exist:
+    REQUIRE(doc.get_errors().size() == 1);
+    doc.erase(doc.get(0x102));
+    REQUIRE(doc.purge() == 1);
+    REQUIRE(doc.get_errors().size() == 1);
+
+    SECTION("log only references to purged objects") {
+        doc.erase(doc.get(0x100));
+        REQUIRE(doc.purge() == 1);
+        REQUIRE(doc.get_errors().size() == 2);
+        REQUIRE(doc.get(0x101)->get_owner_object() == nullptr);
+    }
+}
+
+TEST_CASE("Load invalid DXF structures.", "[document][load]") {
+    SECTION("Log duplicate handles.") {
+        auto doc = load_document(
+                "0\nSECTION\n2\nENTITIES\n0\nLINE\n5\nA\n0\nLINE\n5\nA\n"
+                "0\nENDSEC\n0\nEOF\n");
+        REQUIRE(doc.get_object_table().size() == 1);
+        REQUIRE(doc.get_errors().size() == 1);
+        REQUIRE(doc.get_errors()[0].code ==
+                ezdxf::ErrorCode::kDuplicateHandle);
+    }
+
+    SECTION("Log dangling owner handles.") {
+        auto doc = load_document(
+                "0\nSECTION\n2\nENTITIES\n0\nLINE\n5\nA\n330\nFF\n"
+                "0\nENDSEC\n0\nEOF\n");
+        REQUIRE(doc.get_errors().size() == 1);
+        REQUIRE(doc.get_errors()[0].code ==
+                ezdxf::ErrorCode::kDanglingOwnerHandle);
+    }
+
+    SECTION("Premature end of file.") {
+        auto doc = ezdxf::Document();
+        auto basic_loader = ezdxf::tag::BasicLoader(
+                "0\nSECTION\n2\nENTITIES\n0\nLINE\n5\nA\n");
+        auto loader = ezdxf::tag::AscLoader(basic_loader);
+        REQUIRE(doc.load(loader) == false);
+        REQUIRE(doc.get(0xA) != nullptr);
+    }
+}
@@ -0,0 +1,198 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <sstream>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/acdb/entity.hpp"
+
+using ezdxf::DXFType;
+using ezdxf::ExportOrder;
+
+// DXF data in the format of the AscWriter, this is required to test a
+// round trip:
+static const char *kDXF = R"(  0
+SECTION
+  2
+HEADER
+  9
+$ACADVER
+  1
+AC1024
+  0
+ENDSEC
+  0
+SECTION
+  2
+TABLES
+  0
+TABLE
+  2
+BLOCK_RECORD
+  5
+1
+330
+0
+  0
+BLOCK_RECORD
+  5
+1F
+330
+1
+  2
+*Model_Space
+  0
+ENDTAB
+  0
+ENDSEC
+  0
+SECTION
+  2
+ENTITIES
+  0
+LINE
+  5
+102
+330
+1F
+100
+AcDbEntity
+  8
+0
+  0
+CIRCLE
+  5
+100
+102
+{ACAD_REACTORS
+330
+1F
+102
+}
+330
+1F
+100
+AcDbEntity
+  8
+Circles
+ 40
+1.0
+  0
+ENDSEC
+  0
+EOF
+)";
+
+static ezdxf::Document load_document(const std::string &s) {
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(s);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    REQUIRE(doc.load(loader) == true);
+    return doc;
+}
+
+static std::string export_document(const ezdxf::Document &doc,
+                                   ExportOrder order) {
+    auto stream = std::ostringstream{};
+    doc.export_dxf(stream, order);
+    return stream.str();
+}
+
+TEST_CASE("Export DXF document.", "[document][export]") {
+    auto doc = load_document(kDXF);
+
+    SECTION("Round trip in file order.") {
+        REQUIRE(export_document(doc, ExportOrder::kFileOrder) == kDXF);
+    }
+
+    SECTION("Export entities in handle order.") {
+        auto s = export_document(doc, ExportOrder::kHandleOrder);
+        REQUIRE(s.find("CIRCLE") < s.find("LINE"));
+        // Output is deterministic:
+        REQUIRE(export_document(doc, ExportOrder::kHandleOrder) == s);
+    }
+
+    SECTION("Cached handle order is updated by changes.") {
+        (void) export_document(doc, ExportOrder::kHandleOrder);
+        doc.erase(doc.get(0x100));
+        doc.add(std::make_unique<ezdxf::acdb::Entity>(
+                DXFType::Point, "POINT"));
+        auto s = export_document(doc, ExportOrder::kHandleOrder);
+        REQUIRE(s.find("CIRCLE") == std::string::npos);
+        REQUIRE(s.find("POINT") != std::string::npos);
+    }
+
+    SECTION("Do not export erased entities.") {
+        doc.erase(doc.get(0x100));
+        auto s = export_document(doc, ExportOrder::kFileOrder);
+        REQUIRE(s.find("CIRCLE") == std::string::npos);
+    }
+
+    SECTION("Export changed owner and layer.") {
+        auto circle = dynamic_cast<ezdxf::acdb::Entity *>(doc.get(0x100));
+        circle->set_layer("Layer1");
+        circle->set_owner(0x1E);
+        auto s = export_document(doc, ExportOrder::kFileOrder);
+        REQUIRE(s.find("Circles") == std::string::npos);
+        REQUIRE(s.find("\n102\n}\n330\n1E\n100\nAcDbEntity\n  8\nLayer1\n") !=
+                std::string::npos);
+        // Reactors are not changed:
+        REQUIRE(s.find("{ACAD_REACTORS\n330\n1F\n") != std::string::npos);
+    }
+
+    SECTION("Export new entities.") {
+        auto point = std::make_unique<ezdxf::acdb::Entity>(
+                DXFType::Point, "POINT");
+        point->set_owner(0x1F);
+        doc.add(std::move(point));
+        auto s = export_document(doc, ExportOrder::kFileOrder);
+        REQUIRE(s.find("  0\nPOINT\n  5\n104\n330\n1F\n100\nAcDbEntity\n"
+                       "  8\n0\n  0\nENDSEC\n") != std::string::npos);
+    }
+}
+
+TEST_CASE("Round trip of an ENTITIES-only file.", "[document][export]") {
+    // DXF R12 files may have only an ENTITIES section, no TABLES section
+    // is added:
+    static const char *kEntitiesOnly =
+            "  0\nSECTION\n  2\nENTITIES\n"
+            "  0\nLINE\n  8\n0\n 10\n0\n 20\n0\n 11\n1\n 21\n1\n"
+            "  0\nENDSEC\n  0\nEOF\n";
+    auto doc = load_document(kEntitiesOnly);
+    REQUIRE(doc.get_sections().size() == 1);
+    REQUIRE(doc.get_modelspace_handle() == 0);
+    REQUIRE(export_document(doc, ExportOrder::kFileOrder) == kEntitiesOnly);
+}
+
+TEST_CASE("Export sequences in handle order.", "[document][export]") {
+    // The LINE #25 is between the INSERT #20 and its ATTRIB #30 by handle,
+    // the root DICTIONARY #C is not the smallest handle of the OBJECTS:
+    static const char *kSequence =
+            "  0\nSECTION\n  2\nENTITIES\n"
+            "  0\nINSERT\n  5\n20\n  8\n0\n 66\n1\n  2\nDOOR\n"
+            "  0\nATTRIB\n  5\n30\n330\n20\n  8\n0\n"
+            "  0\nSEQEND\n  5\n31\n330\n20\n  8\n0\n"
+            "  0\nLINE\n  5\n25\n  8\n0\n"
+            "  0\nENDSEC\n"
+            "  0\nSECTION\n  2\nOBJECTS\n"
+            "  0\nDICTIONARY\n  5\nC\n330\n0\n"
+            "  0\nXRECORD\n  5\nA\n330\nC\n"
+            "  0\nENDSEC\n  0\nEOF\n";
+    auto doc = load_document(kSequence);
+    auto const s = export_document(doc, ExportOrder::kHandleOrder);
+    // The file order is the valid order:
+    REQUIRE(s == kSequence);
+
+    SECTION("round trip") {
+        auto reloaded = load_document(s);
+        REQUIRE(export_document(reloaded, ExportOrder::kHandleOrder) == s);
+    }
+
+    SECTION("erased ATTRIB") {
+        doc.erase(doc.get(0x30));
+        auto const erased = export_document(doc, ExportOrder::kHandleOrder);
+        REQUIRE(erased.find("ATTRIB") == std::string::npos);
+        REQUIRE(erased.find("INSERT") < erased.find("SEQEND"));
+        REQUIRE(erased.find("SEQEND") < erased.find("LINE"));
+    }
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+// Run this tests also with ThreadSanitizer:
+// cmake -DEZDXF_SANITIZE_THREAD=ON ...
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/acdb/entity.hpp"
+
+using ezdxf::DXFType;
+using ezdxf::Handle;
+
+static std::string make_dxf(Handle count) {
+    // Modelspace BLOCK_RECORD #1 and alternating LINE and CIRCLE entities
+    // starting at handle #100:
+    auto s = std::ostringstream{};
+    s << std::uppercase << std::hex;
+    s << "0\nSECTION\n2\nTABLES\n0\nBLOCK_RECORD\n5\n1\n2\n*Model_Space\n"
+         "0\nENDSEC\n0\nSECTION\n2\nENTITIES\n";
+    for (Handle h = 0x100; h < 0x100 + count; ++h) {
+        s << "0\n" << (h & 1 ? "CIRCLE" : "LINE") << "\n5\n" << h
+          << "\n330\n1\n8\n0\n340\n" << h - 1 << "\n";
+    }
+    s << "0\nENDSEC\n0\nEOF\n";
+    return s.str();
+}
+
+TEST_CASE("Frozen documents are immutable.", "[document][freeze]") {
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(make_dxf(10));
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    doc.load(loader);
+    REQUIRE(doc.is_frozen() == false);
+    doc.freeze();
+    REQUIRE(doc.is_frozen() == true);
+
+    REQUIRE_THROWS_AS(doc.load(loader), std::logic_error);
+    REQUIRE_THROWS_AS(doc.erase(doc.get(0x100)), std::logic_error);
+    REQUIRE_THROWS_AS(doc.purge(), std::logic_error);
+    REQUIRE_THROWS_AS(doc.add(std::make_unique<ezdxf::acdb::Object>()),
+                      std::logic_error);
+    REQUIRE(doc.get(0x100)->is_alive() == true);
+}
+
+TEST_CASE("Concurrent readers of a frozen document.", "[document][freeze]") {
+    const Handle count = 10000;
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(make_dxf(count));
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    REQUIRE(doc.load(loader) == true);
+    doc.freeze();
+
+    auto expected_dxf = std::ostringstream{};
+    doc.export_dxf(expected_dxf, ezdxf::ExportOrder::kHandleOrder);
+
+    std::atomic<int> failures{0};
+    auto reader = [&doc, &failures, &expected_dxf, count]() {
+        auto const &table = doc.get_object_table();
+        for (Handle h = 0x100; h < 0x100 + count; ++h) {
+            auto object = doc.get(h);
+            if (!object || object->get_handle() != h) ++failures;
+            // Resolved references:
+            if (h > 0x100 &&
+                object->get_references()[0].object != doc.get(h - 1))
+                ++failures;
+        }
+        std::size_t alive = 0;
+        table.for_each_alive([&alive](ezdxf::acdb::Object *) { ++alive; });
+        if (alive != table.size()) ++failures;
+        Handle previous = 0;
+        for (auto const object : table.handle_order()) {
+            if (object->get_handle() <= previous) ++failures;
+            previous = object->get_handle();
+        }
+        for (auto const entity : doc.query(DXFType::Circle)) {
+            if (entity->dxf_type() != DXFType::Circle) ++failures;
+        }
+        if (doc.children(1).size() != count) ++failures;
+        auto layers = std::size_t{0};
+        for (auto const object : table) {
+            auto entity = dynamic_cast<const ezdxf::acdb::Entity *>(object);
+            if (entity && entity->get_layer() == "0") ++layers;
+        }
+        if (layers != count) ++failures;
+        auto s = std::ostringstream{};
+        doc.export_dxf(s, ezdxf::ExportOrder::kHandleOrder);
+        if (s.str() != expected_dxf.str()) ++failures;
+    };
+
+    auto threads = std::vector<std::thread>{};
+    for (int i = 0; i < 8; ++i) threads.emplace_back(reader);
+    for (auto &thread : threads) thread.join();
+    REQUIRE(failures == 0);
+}
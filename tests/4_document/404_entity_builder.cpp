@@ -0,0 +1,155 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+// Run this tests also with ThreadSanitizer:
+// cmake -DEZDXF_SANITIZE_THREAD=ON ...
+#include <catch2/catch.hpp>
+#include <set>
+#include <sstream>
+#include <thread>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/acdb/entity.hpp"
+
+using ezdxf::DXFType;
+using ezdxf::Handle;
+
+static const char *kDXF = "0\nSECTION\n2\nTABLES\n"
+                          "0\nBLOCK_RECORD\n5\n1F\n2\n*Model_Space\n"
+                          "0\nENDSEC\n0\nSECTION\n2\nENTITIES\n"
+                          "0\nLINE\n5\n100\n330\n1F\n8\n0\n"
+                          "0\nENDSEC\n0\nEOF\n";
+
+static ezdxf::Document load_document() {
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(kDXF);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    doc.load(loader);
+    return doc;
+}
+
+static std::unique_ptr<ezdxf::acdb::Entity>
+make_entity(DXFType type, Handle owner) {
+    auto entity = std::make_unique<ezdxf::acdb::Entity>(
+            type, type == DXFType::Line ? "LINE" : "POINT");
+    entity->set_owner(owner);
+    return entity;
+}
+
+TEST_CASE("Reserve handle blocks.", "[document][builder]") {
+    auto doc = load_document();
+    REQUIRE(doc.reserve_handles(16) == 0x101);
+    REQUIRE(doc.reserve_handles(16) == 0x111);
+    // Reserved handles are not reused:
+    auto point = doc.add(make_entity(DXFType::Point, 0x1F));
+    REQUIRE(point->get_handle() == 0x121);
+}
+
+TEST_CASE("Merge entity builders.", "[document][builder]") {
+    auto doc = load_document();
+    auto builders = std::vector<ezdxf::EntityBuilder>{};
+    builders.emplace_back(doc, 2);
+    builders.emplace_back(doc, 2);
+    // Each builder reserved its first handle block:
+    auto line = builders[1].add(make_entity(DXFType::Line, 0x1F));
+    REQUIRE(line->get_handle() == 0x103);
+    auto point = builders[0].add(make_entity(DXFType::Point, 0x1F));
+    REQUIRE(point->get_handle() == 0x101);
+    builders[0].add(make_entity(DXFType::Point, 0x1F));
+    // Reserve a new block of 2 handles:
+    auto last = builders[0].add(make_entity(DXFType::Point, 0x1F));
+    REQUIRE(last->get_handle() == 0x105);
+
+    doc.merge(builders);
+    REQUIRE(builders[0].empty() == true);
+    REQUIRE(builders[1].empty() == true);
+    REQUIRE(doc.get(0x105) == last);
+    REQUIRE(doc.query(DXFType::Point).size() == 3);
+    REQUIRE(doc.children(0x1F).size() == 5);
+    REQUIRE(line->get_owner_object() == doc.get(0x1F));
+
+    SECTION("objects are appended in builder order") {
+        auto const &entities = doc.get_sections().back().objects;
+        REQUIRE(entities.size() == 5);
+        REQUIRE(entities[1] == point);
+        REQUIRE(entities[3] == last);
+        REQUIRE(entities[4] == line);
+    }
+}
+
+TEST_CASE("Merge resolves references between merged objects.",
+          "[document][builder]") {
+    auto doc = load_document();
+    auto builders = std::vector<ezdxf::EntityBuilder>{};
+    builders.emplace_back(doc);
+    auto first = builders[0].add(make_entity(DXFType::Line, 0x1F));
+    auto second = builders[0].add(make_entity(DXFType::Line, 0x1F));
+    // Forward reference to an object created later:
+    first->add_reference(340, second->get_handle());
+    doc.merge(builders);
+    REQUIRE(first->get_references()[0].object == second);
+    REQUIRE(doc.get_errors().empty() == true);
+}
+
+TEST_CASE("Duplicate handles of merged objects are ignored.",
+          "[document][builder]") {
+    auto doc = load_document();
+    auto builders = std::vector<ezdxf::EntityBuilder>{};
+    builders.emplace_back(doc);
+    auto entity = make_entity(DXFType::Line, 0x1F);
+    entity->set_handle(0x100);
+    builders[0].add(std::move(entity));
+    doc.merge(builders);
+    REQUIRE(doc.query(DXFType::Line).size() == 1);
+    REQUIRE(doc.get_errors().back().code == ezdxf::ErrorCode::kDuplicateHandle);
+}
+
+TEST_CASE("Merged objects do not reuse handles of unstored entities.",
+          "[document][builder]") {
+    // The VERTEX and SEQEND entities are not stored in the object table,
+    // the POINT is skipped by the type filter:
+    static const char *kSequence =
+            "0\nSECTION\n2\nENTITIES\n"
+            "0\nPOLYLINE\n5\n100\n8\n0\n66\n1\n70\n0\n"
+            "0\nVERTEX\n5\n101\n8\n0\n10\n0\n20\n0\n30\n0\n70\n0\n"
+            "0\nSEQEND\n5\n102\n8\n0\n"
+            "0\nPOINT\n5\n103\n8\n0\n"
+            "0\nENDSEC\n0\nEOF\n";
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(kSequence);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    doc.load(loader, ezdxf::LoadOptions{{DXFType::Polyline}});
+    REQUIRE(doc.get_errors().empty() == true);
+    auto const handle = GENERATE(Handle(0x101), Handle(0x102), Handle(0x103));
+    auto builders = std::vector<ezdxf::EntityBuilder>{};
+    builders.emplace_back(doc);
+    auto entity = make_entity(DXFType::Line, 0);
+    entity->set_handle(handle);
+    builders[0].add(std::move(entity));
+    doc.merge(builders);
+    REQUIRE(doc.get(handle) == nullptr);
+    REQUIRE(doc.get_errors().back().code == ezdxf::ErrorCode::kDuplicateHandle);
+}
+
+TEST_CASE("Entity builders in parallel threads.", "[document][builder]") {
+    const std::size_t count = 10000;
+    auto doc = load_document();
+    auto builders = std::vector<ezdxf::EntityBuilder>{};
+    for (int i = 0; i < 4; ++i) builders.emplace_back(doc, 100);
+    auto threads = std::vector<std::thread>{};
+    for (auto &builder : builders) {
+        threads.emplace_back([&builder, count]() {
+            for (std::size_t i = 0; i < count; ++i)
+                builder.add(make_entity(DXFType::Point, 0x1F));
+        });
+    }
+    for (auto &thread : threads) thread.join();
+    doc.merge(builders);
+
+    auto const &points = doc.query(DXFType::Point);
+    REQUIRE(points.size() == 4 * count);
+    auto handles = std::set<Handle>{};
+    for (auto point : points) handles.insert(point->get_handle());
+    REQUIRE(handles.size() == 4 * count);
+    REQUIRE(handles.count(0x100) == 0);
+    REQUIRE(doc.get_errors().empty() == true);
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <sstream>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/acdb/entity.hpp"
+
+using ezdxf::DXFType;
+using ezdxf::Handle;
+
+static const char *kDXF = "0\nSECTION\n2\nHEADER\n9\n$ACADVER\n1\nAC1024\n"
+                          "0\nENDSEC\n0\nSECTION\n2\nTABLES\n"
+                          "0\nBLOCK_RECORD\n5\n1F\n2\n*Model_Space\n"
+                          "0\nENDTAB\n"
+                          "0\nENDSEC\n0\nSECTION\n2\nENTITIES\n"
+                          "999\ncomment\n"
+                          "0\r\nLINE\r\n5\r\n100\r\n330\r\n1F\r\n8\r\nWALLS\r\n"
+                          "0\nCIRCLE\n5\n101\n330\n1F\n340\n100\n"
+                          "0\nPOINT\n5\n100\n330\n1F\n"
+                          "0\nENDSEC\n0\nEOF\n";
+
+static ezdxf::Document load_lazy(const char *data) {
+    auto doc = ezdxf::Document();
+    REQUIRE(doc.load_lazy(std::make_unique<std::istringstream>(
+            data, std::ios::binary)) == true);
+    return doc;
+}
+
+static ezdxf::Document load(const char *data) {
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(data);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    doc.load(loader);
+    return doc;
+}
+
+TEST_CASE("Lazy loading loads objects on first access.", "[document][lazy]") {
+    auto doc = load_lazy(kDXF);
+    REQUIRE(doc.is_lazy() == true);
+    REQUIRE(doc.get_object_table().size() == 0);
+    REQUIRE(doc.get_sections().size() == 3);
+    REQUIRE(doc.get_sections()[0].tags.size() == 2);
+
+    auto line = dynamic_cast<ezdxf::acdb::Entity *>(doc.get(0x100));
+    REQUIRE(line != nullptr);
+    REQUIRE(line->dxf_type() == DXFType::Line);
+    REQUIRE(line->get_layer() == "WALLS");
+    REQUIRE(line->get_owner() == 0x1F);
+    REQUIRE(doc.get_object_table().size() == 1);
+    // The second access does not load the object again:
+    REQUIRE(doc.get(0x100) == line);
+    REQUIRE(doc.get(0xFFFF) == nullptr);
+
+    SECTION("the ENDTAB object got a handle by the prescan") {
+        REQUIRE(doc.get(0x102)->get_handle() == 0x102);
+    }
+
+    SECTION("export requires a completely loaded document") {
+        auto stream = std::ostringstream{};
+        REQUIRE_THROWS_AS(doc.export_dxf(stream), std::logic_error);
+    }
+}
+
+TEST_CASE("Materialize all objects of a lazy document.", "[document][lazy]") {
+    auto doc = load_lazy(kDXF);
+    auto line = doc.get(0x100);
+    REQUIRE(doc.materialize_all() == 3);
+    REQUIRE(doc.is_lazy() == false);
+    // Loaded objects are preserved:
+    REQUIRE(doc.get(0x100) == line);
+    REQUIRE(doc.get_modelspace_handle() == 0x1F);
+    REQUIRE(doc.query(DXFType::Circle).size() == 1);
+    REQUIRE(doc.get(0x101)->get_references()[0].object == line);
+
+    SECTION("duplicate handles are ignored like by load()") {
+        REQUIRE(doc.query(DXFType::Point).empty() == true);
+        REQUIRE(doc.get_errors().back().code ==
+                ezdxf::ErrorCode::kDuplicateHandle);
+    }
+
+    SECTION("export equals the export of the eager loaded document") {
+        auto expected = std::ostringstream{};
+        load(kDXF).export_dxf(expected);
+        auto result = std::ostringstream{};
+        doc.export_dxf(result);
+        REQUIRE(result.str() == expected.str());
+    }
+}
+
+TEST_CASE("Changing a lazy document loads all objects.", "[document][lazy]") {
+    auto doc = load_lazy(kDXF);
+    doc.add(std::make_unique<ezdxf::acdb::Entity>(DXFType::Point, "POINT"));
+    REQUIRE(doc.is_lazy() == false);
+    REQUIRE(doc.get_object_table().size() == 5);
+
+    SECTION("freeze loads all objects") {
+        auto frozen = load_lazy(kDXF);
+        frozen.freeze();
+        REQUIRE(frozen.is_lazy() == false);
+        REQUIRE(frozen.get_object_table().size() == 4);
+    }
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/acdb/entity.hpp"
+
+using ezdxf::DXFType;
+
+static const char *kDXF = "0\nSECTION\n2\nHEADER\n9\n$ACADVER\n1\nAC1024\n"
+                          "0\nENDSEC\n0\nSECTION\n2\nTABLES\n"
+                          "0\nBLOCK_RECORD\n5\n1F\n2\n*Model_Space\n"
+                          "0\nENDTAB\n"
+                          "0\nENDSEC\n0\nSECTION\n2\nENTITIES\n"
+                          "0\nLINE\n5\n100\n330\n1F\n8\nWALLS\n"
+                          "0\nCIRCLE\n5\n101\n330\n1F\n340\n100\n"
+                          "0\nENDSEC\n0\nEOF\n";
+
+static std::string read_file(const std::string &filename) {
+    auto stream = std::ifstream(filename, std::ios::binary);
+    return {std::istreambuf_iterator<char>(stream), {}};
+}
+
+static std::string export_dxf(ezdxf::Document &doc) {
+    doc.materialize_all();
+    auto stream = std::ostringstream{};
+    doc.export_dxf(stream);
+    return stream.str();
+}
+
+TEST_CASE("Save and restore the lazy loading index.", "[document][lazy]") {
+    auto doc = ezdxf::Document();
+    doc.load_lazy(std::make_unique<std::istringstream>(kDXF));
+    auto index = std::stringstream{};
+    REQUIRE(doc.save_lazy_index(index) == true);
+
+    auto restored = ezdxf::Document();
+    REQUIRE(restored.load_lazy(std::make_unique<std::istringstream>(kDXF),
+                               index) == true);
+    REQUIRE(restored.is_lazy() == true);
+    REQUIRE(restored.get_sections().size() == 3);
+    auto line = dynamic_cast<ezdxf::acdb::Entity *>(restored.get(0x100));
+    REQUIRE(line->get_layer() == "WALLS");
+    // The handle of the ENDTAB object is restored:
+    REQUIRE(restored.get(0x102) != nullptr);
+    // Restored handle counter:
+    REQUIRE(restored.reserve_handles(1) == 0x103);
+    REQUIRE(export_dxf(restored) == export_dxf(doc));
+
+    SECTION("completely loaded documents have no lazy loading index") {
+        REQUIRE(doc.save_lazy_index(index) == false);
+    }
+}
+
+TEST_CASE("Reject invalid lazy loading index data.", "[document][lazy]") {
+    auto doc = ezdxf::Document();
+    doc.load_lazy(std::make_unique<std::istringstream>(kDXF));
+    auto stream = std::stringstream{};
+    doc.save_lazy_index(stream);
+    auto data = stream.str();
+
+    SECTION("truncated data") {
+        auto index = std::istringstream(data.substr(0, data.size() - 3));
+        auto restored = ezdxf::Document();
+        REQUIRE(restored.load_lazy(
+                std::make_unique<std::istringstream>(kDXF), index) == false);
+        REQUIRE(restored.is_lazy() == false);
+        REQUIRE(restored.get_sections().empty() == true);
+    }
+
+    SECTION("invalid magic") {
+        data[6] = 'x';
+        auto index = std::istringstream(data);
+        auto restored = ezdxf::Document();
+        REQUIRE(restored.load_lazy(
+                std::make_unique<std::istringstream>(kDXF), index) == false);
+    }
+}
+
+TEST_CASE("Reuse the sidecar index file.", "[document][lazy]") {
+    namespace fs = std::filesystem;
+    auto const filename =
+            (fs::temp_directory_path() / "ezdxf_406_sidecar.dxf").string();
+    auto const index_filename = ezdxf::sidecar_index_filename(filename);
+    fs::remove(index_filename);
+    std::ofstream(filename, std::ios::binary) << kDXF;
+
+    auto doc = ezdxf::readfile_indexed(filename);
+    REQUIRE(doc.is_lazy() == true);
+    REQUIRE(doc.filename == filename);
+    REQUIRE(fs::exists(index_filename) == true);
+    auto expected = export_dxf(doc);
+
+    SECTION("valid sidecar index") {
+        auto indexed = ezdxf::readfile_indexed(filename);
+        REQUIRE(indexed.is_lazy() == true);
+        REQUIRE(export_dxf(indexed) == expected);
+    }
+
+    SECTION("outdated sidecar index is replaced") {
+        auto const old_index = read_file(index_filename);
+        std::ofstream(filename, std::ios::binary)
+                << std::string(kDXF).replace(0, 1, "  0");
+        auto indexed = ezdxf::readfile_indexed(filename);
+        // Offsets of the new file are 2 bytes bigger:
+        auto line = indexed.get(0x100);
+        REQUIRE(line != nullptr);
+        REQUIRE(line->dxf_type() == DXFType::Line);
+        REQUIRE(read_file(index_filename) != old_index);
+        REQUIRE(export_dxf(indexed) == expected);
+    }
+    fs::remove(filename);
+    fs::remove(index_filename);
+}
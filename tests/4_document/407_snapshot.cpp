@@ -0,0 +1,191 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/snapshot.hpp"
+#include "ezdxf/utils.hpp"
+#include "ezdxf/acdb/entity.hpp"
+
+using ezdxf::DXFType;
+
+static const char *kDXF = "0\nSECTION\n2\nHEADER\n9\n$ACADVER\n1\nAC1024\n"
+                          "0\nENDSEC\n0\nSECTION\n2\nTABLES\n"
+                          "0\nBLOCK_RECORD\n5\n1F\n2\n*Model_Space\n"
+                          "0\nENDTAB\n"
+                          "0\nENDSEC\n0\nSECTION\n2\nENTITIES\n"
+                          "0\nLINE\n5\n100\n330\n1F\n8\nWALLS\n"
+                          "0\nCIRCLE\n5\n101\n330\n1F\n340\n100\n"
+                          "0\nPOINT\n5\n102\n330\nFF\n"
+                          "0\nENDSEC\n0\nEOF\n";
+
+static ezdxf::Document load() {
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(kDXF);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    doc.load(loader);
+    return doc;
+}
+
+static std::string export_dxf(const ezdxf::Document &doc) {
+    auto stream = std::ostringstream{};
+    doc.export_dxf(stream);
+    return stream.str();
+}
+
+static std::string save_snapshot(const ezdxf::Document &doc) {
+    auto stream = std::ostringstream{};
+    REQUIRE(doc.save_snapshot(stream) == true);
+    return stream.str();
+}
+
+TEST_CASE("Snapshot round trip.", "[document][snapshot]") {
+    auto doc = load();
+    auto point = std::make_unique<ezdxf::acdb::Entity>(DXFType::Point, "POINT");
+    point->set_layer("NEW");
+    doc.add(std::move(point));
+    doc.erase(doc.get(0x102));
+    (void) doc.reserve_handles(10);
+
+    auto stream = std::istringstream(save_snapshot(doc));
+    auto restored = ezdxf::Document();
+    REQUIRE(restored.load_snapshot(stream) == true);
+    REQUIRE(export_dxf(restored) == export_dxf(doc));
+    // Erased objects are not stored:
+    REQUIRE(restored.get(0x102) == nullptr);
+    REQUIRE(restored.get_modelspace_handle() == 0x1F);
+    REQUIRE(restored.query(DXFType::Point).size() == 1);
+    REQUIRE(restored.children(0x1F).size() == 2);
+    REQUIRE(restored.get(0x101)->get_references()[0].object ==
+            restored.get(0x100));
+    REQUIRE(restored.get_errors().size() == doc.get_errors().size());
+    // Reserved handles are not reused:
+    REQUIRE(restored.reserve_handles(1) == doc.reserve_handles(1));
+}
+
+TEST_CASE("Reject invalid snapshots.", "[document][snapshot]") {
+    auto data = save_snapshot(load());
+    auto restored = ezdxf::Document();
+    restored.filename = "unchanged";
+
+    SECTION("invalid checksum") {
+        data[data.size() / 2] ^= 1;
+        auto stream = std::istringstream(data);
+        REQUIRE(restored.load_snapshot(stream) == false);
+    }
+
+    SECTION("truncated snapshot") {
+        auto stream = std::istringstream(data.substr(0, data.size() - 8));
+        REQUIRE(restored.load_snapshot(stream) == false);
+    }
+
+    SECTION("invalid version") {
+        data[8] = 99;
+        auto stream = std::istringstream(data);
+        REQUIRE(restored.load_snapshot(stream) == false);
+    }
+
+    SECTION("DXF data") {
+        auto stream = std::istringstream(kDXF);
+        REQUIRE(restored.load_snapshot(stream) == false);
+    }
+
+    SECTION("tampered records with a valid checksum") {
+        using namespace ezdxf::snapshot;
+        auto const payload = data.data() + sizeof(Header);
+        auto directory = Directory{};
+        std::memcpy(&directory, payload, sizeof(Directory));
+        auto const tamper = [&](uint64_t offset, uint32_t value) {
+            std::memcpy(&data[sizeof(Header) + offset], &value,
+                        sizeof(value));
+            auto header = Header{};
+            std::memcpy(&header, data.data(), sizeof(Header));
+            header.checksum = ezdxf::utils::fnv1a_hash(
+                    data.data() + sizeof(Header), header.payload_size);
+            std::memcpy(data.data(), &header, sizeof(Header));
+        };
+        // The first object record is the loaded BLOCK_RECORD:
+        auto const object = directory.objects.offset;
+        SECTION("loaded acdb::Object") {
+            tamper(object + offsetof(ObjectRecord, kind),
+                   static_cast<uint32_t>(ObjectKind::kObject));
+        }
+        SECTION("unknown flags") {
+            tamper(object + offsetof(ObjectRecord, flags), kLoaded | 2);
+        }
+        SECTION("duplicate handle") {
+            tamper(object + sizeof(ObjectRecord) +
+                   offsetof(ObjectRecord, handle), 0x1F);
+        }
+        SECTION("unknown error code") {
+            REQUIRE(directory.errors.count > 0);
+            tamper(directory.errors.offset + offsetof(ErrorRecord, code),
+                   999);
+        }
+        auto stream = std::istringstream(data);
+        REQUIRE(restored.load_snapshot(stream) == false);
+    }
+    // The document is unchanged:
+    REQUIRE(restored.filename == "unchanged");
+    REQUIRE(restored.get_sections().empty() == true);
+    REQUIRE(restored.get_object_table().size() == 0);
+}
+
+TEST_CASE("Snapshot requires an empty document.", "[document][snapshot]") {
+    auto stream = std::istringstream(save_snapshot(load()));
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(
+            "0\nSECTION\n2\nHEADER\n0\nENDSEC\n0\nEOF\n");
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    doc.load(loader);
+    REQUIRE(doc.get_object_table().size() == 0);
+    REQUIRE_THROWS_AS(doc.load_snapshot(stream), std::logic_error);
+}
+
+TEST_CASE("Snapshot of handles in use.", "[document][snapshot]") {
+    // The handles of the VERTEX and SEQEND entities and of the skipped
+    // POINT are in use, but not stored in the object table:
+    static const char *kSequence =
+            "0\nSECTION\n2\nENTITIES\n"
+            "0\nPOLYLINE\n5\n100\n8\n0\n66\n1\n70\n0\n"
+            "0\nVERTEX\n5\n101\n8\n0\n10\n0\n20\n0\n30\n0\n70\n0\n"
+            "0\nSEQEND\n5\n102\n8\n0\n"
+            "0\nPOINT\n5\n103\n8\n0\n"
+            "0\nENDSEC\n0\nEOF\n";
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(kSequence);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    doc.load(loader, ezdxf::LoadOptions{{DXFType::Polyline}});
+    auto stream = std::istringstream(save_snapshot(doc));
+    auto restored = ezdxf::Document();
+    REQUIRE(restored.load_snapshot(stream) == true);
+    REQUIRE(restored.get_skipped_handles() ==
+            std::vector<ezdxf::Handle>{0x103});
+
+    auto const handle = GENERATE(ezdxf::Handle(0x102), ezdxf::Handle(0x103));
+    auto builders = std::vector<ezdxf::EntityBuilder>{};
+    builders.emplace_back(restored);
+    auto point = std::make_unique<ezdxf::acdb::Entity>(DXFType::Point, "POINT");
+    point->set_handle(handle);
+    builders[0].add(std::move(point));
+    restored.merge(builders);
+    REQUIRE(restored.get(handle) == nullptr);
+    REQUIRE(restored.get_errors().back().code ==
+            ezdxf::ErrorCode::kDuplicateHandle);
+}
+
+TEST_CASE("Snapshot files.", "[document][snapshot]") {
+    namespace fs = std::filesystem;
+    auto const filename =
+            (fs::temp_directory_path() / "ezdxf_407_snapshot.ezsnp").string();
+    auto doc = load();
+    REQUIRE(ezdxf::writesnapshot(doc, filename) == true);
+    auto restored = ezdxf::readsnapshot(filename);
+    REQUIRE(restored.filename == filename);
+    REQUIRE(export_dxf(restored) == export_dxf(doc));
+    fs::remove(filename);
+}
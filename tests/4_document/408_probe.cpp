@@ -0,0 +1,57 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include "ezdxf/probe.hpp"
+
+using ezdxf::Version;
+
+static const char *kDXF = "0\nSECTION\n2\nHEADER\n"
+                          "9\n$ACADVER\n1\nAC1027\n"
+                          "9\n$DWGCODEPAGE\n3\nANSI_1252\n"
+                          "9\n$EXTMIN\n10\n-1.5\n20\n-2\n30\n0\n"
+                          "9\n$EXTMAX\n10\n100\n20\n200.25\n30\n3\n"
+                          "9\n$INSUNITS\n70\n4\n"
+                          "9\n$HANDSEED\n5\n20000\n"
+                          "0\nENDSEC\n"
+                          "0\nSECTION\n2\nENTITIES\n0\nENDSEC\n0\nEOF\n";
+
+TEST_CASE("Probe the HEADER section.", "[probe]") {
+    auto basic_loader = ezdxf::tag::BasicLoader(kDXF);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    auto info = ezdxf::probe(loader);
+    REQUIRE(info.valid == true);
+    REQUIRE(info.acadver == "AC1027");
+    REQUIRE(info.version == Version::R2013);
+    REQUIRE(info.codepage == "ANSI_1252");
+    REQUIRE(info.has_extents == true);
+    REQUIRE(info.extmin.x() == -1.5);
+    REQUIRE(info.extmin.y() == -2.0);
+    REQUIRE(info.extmax.y() == 200.25);
+    REQUIRE(info.extmax.z() == 3.0);
+    REQUIRE(info.insunits == 4);
+    REQUIRE(info.handseed == 0x20000);
+    // Loading stops at the end of the HEADER section:
+    REQUIRE(loader.peek().equals(0, "ENDSEC"));
+    REQUIRE(loader.get_line_number() < 40);
+}
+
+TEST_CASE("Probe missing header variables.", "[probe]") {
+    auto basic_loader = ezdxf::tag::BasicLoader(
+            "0\nSECTION\n2\nHEADER\n9\n$EXTMIN\n10\n1\n20\n1\n0\nENDSEC\n");
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    auto info = ezdxf::probe(loader);
+    REQUIRE(info.valid == true);
+    REQUIRE(info.acadver.empty() == true);
+    REQUIRE(info.version == Version::R12);
+    REQUIRE(info.has_extents == false);
+    REQUIRE(info.handseed == 0);
+}
+
+TEST_CASE("Probe DXF data without HEADER section.", "[probe]") {
+    auto basic_loader = ezdxf::tag::BasicLoader(
+            "0\nSECTION\n2\nENTITIES\n0\nENDSEC\n0\nEOF\n");
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    REQUIRE(ezdxf::probe(loader).valid == false);
+    REQUIRE(ezdxf::probe("xxx-does-not-exist.dxf").valid == false);
+}
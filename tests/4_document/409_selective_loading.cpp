@@ -0,0 +1,137 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/acdb/entity.hpp"
+
+using ezdxf::DXFType;
+using ezdxf::Handle;
+using ezdxf::LoadOptions;
+
+static const char *kDXF = "0\nSECTION\n2\nTABLES\n"
+                          "0\nBLOCK_RECORD\n5\n1F\n2\n*Model_Space\n"
+                          "0\nENDTAB\n5\n20\n"
+                          "0\nENDSEC\n0\nSECTION\n2\nENTITIES\n"
+                          "0\nLINE\n5\n100\n330\n1F\n8\nWalls\n"
+                          "0\nCIRCLE\n5\n101\n330\n1F\n340\n100\n8\nDOORS\n"
+                          "0\nPOINT\n5\n102\n330\n1F\n"
+                          "0\nPOINT\n5\n103\n330\n1F\n8\nwalls\n"
+                          "0\nENDSEC\n0\nEOF\n";
+
+static ezdxf::Document load(const LoadOptions &options) {
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(kDXF);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    REQUIRE(doc.load(loader, options) == true);
+    return doc;
+}
+
+TEST_CASE("Load all entities without filters.", "[document][selective]") {
+    auto doc = load(LoadOptions{});
+    REQUIRE(doc.get_sections()[1].objects.size() == 4);
+    REQUIRE(doc.get_skipped_handles().empty());
+    REQUIRE(doc.get_errors().empty());
+}
+
+TEST_CASE("Load entities by type.", "[document][selective]") {
+    auto doc = load(LoadOptions{{DXFType::Point, DXFType::Circle}});
+    REQUIRE(doc.get_sections()[1].objects.size() == 3);
+    REQUIRE(doc.get(0x100) == nullptr);
+    REQUIRE(doc.query(DXFType::Point).size() == 2);
+    REQUIRE(doc.get_skipped_handles() == std::vector<Handle>{0x100});
+
+    SECTION("non-entity objects are always loaded") {
+        REQUIRE(doc.get(0x1F) != nullptr);
+        REQUIRE(doc.get(0x20) != nullptr);
+    }
+
+    SECTION("pointers to skipped entities are not dangling pointers") {
+        REQUIRE(doc.get_errors().empty());
+    }
+
+    SECTION("handles of skipped entities are not reused") {
+        REQUIRE(doc.get_object_table().max_handle() >= 0x103);
+    }
+}
+
+TEST_CASE("Load entities by layer.", "[document][selective]") {
+    SECTION("layer names are case insensitive") {
+        auto doc = load(LoadOptions{{}, {"WALLS"}});
+        REQUIRE(doc.get_sections()[1].objects.size() == 2);
+        REQUIRE(doc.get(0x100) != nullptr);
+        REQUIRE(doc.get(0x103) != nullptr);
+        REQUIRE(doc.get_skipped_handles() ==
+                std::vector<Handle>{0x101, 0x102});
+        REQUIRE(doc.get_errors().empty());
+    }
+
+    SECTION("entities without layer tag are on layer 0") {
+        auto doc = load(LoadOptions{{}, {"0"}});
+        REQUIRE(doc.get_sections()[1].objects.size() == 1);
+        REQUIRE(doc.get(0x102) != nullptr);
+    }
+
+    SECTION("loaded entities match the type and the layer filter") {
+        auto doc = load(LoadOptions{{DXFType::Point}, {"walls"}});
+        REQUIRE(doc.get_sections()[1].objects.size() == 1);
+        auto point = dynamic_cast<ezdxf::acdb::Entity *>(doc.get(0x103));
+        REQUIRE(point != nullptr);
+        REQUIRE(point->get_layer() == "walls");
+        REQUIRE(point->get_owner() == 0x1F);
+    }
+}
+
+TEST_CASE("INSERT sequences are loaded or skipped as a unit.",
+          "[document][selective]") {
+    static const char *kInsert =
+            "0\nSECTION\n2\nENTITIES\n"
+            "0\nINSERT\n5\n200\n8\nWALLS\n66\n1\n2\nDOOR\n"
+            "0\nATTRIB\n5\n201\n330\n200\n8\nTEXT\n"
+            "0\nATTRIB\n5\n202\n330\n200\n8\nTEXT\n"
+            "0\nSEQEND\n5\n203\n330\n200\n8\nWALLS\n"
+            "0\nATTRIB\n5\n204\n8\nTEXT\n"  // orphaned ATTRIB
+            "0\nLINE\n5\n205\n8\nTEXT\n"
+            "0\nENDSEC\n0\nEOF\n";
+    auto const load = [](const LoadOptions &options) {
+        auto doc = ezdxf::Document();
+        auto basic_loader = ezdxf::tag::BasicLoader(kInsert);
+        auto loader = ezdxf::tag::AscLoader(basic_loader);
+        REQUIRE(doc.load(loader, options) == true);
+        return doc;
+    };
+    auto const handles = [](const ezdxf::Document &doc) {
+        auto result = std::vector<Handle>{};
+        for (auto const object : doc.get_sections()[0].objects)
+            result.push_back(object->get_handle());
+        return result;
+    };
+
+    SECTION("type filter accepts the INSERT") {
+        auto doc = load(LoadOptions{{DXFType::Insert}});
+        REQUIRE(handles(doc) ==
+                std::vector<Handle>{0x200, 0x201, 0x202, 0x203});
+        REQUIRE(doc.get_skipped_handles() ==
+                std::vector<Handle>{0x204, 0x205});
+    }
+
+    SECTION("type filter skips the INSERT") {
+        auto doc = load(LoadOptions{{DXFType::Attrib}});
+        REQUIRE(handles(doc) == std::vector<Handle>{0x204});
+        REQUIRE(doc.get_skipped_handles() ==
+                std::vector<Handle>{0x200, 0x201, 0x202, 0x203, 0x205});
+    }
+
+    SECTION("layer filter accepts the INSERT") {
+        auto doc = load(LoadOptions{{}, {"WALLS"}});
+        REQUIRE(handles(doc) ==
+                std::vector<Handle>{0x200, 0x201, 0x202, 0x203});
+    }
+
+    SECTION("layer filter skips the INSERT") {
+        auto doc = load(LoadOptions{{}, {"TEXT"}});
+        REQUIRE(handles(doc) == std::vector<Handle>{0x204, 0x205});
+        REQUIRE(doc.get_skipped_handles() ==
+                std::vector<Handle>{0x200, 0x201, 0x202, 0x203});
+    }
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include "ezdxf/batch.hpp"
+
+namespace fs = std::filesystem;
+
+static std::string write_dxf(const std::string &name, int point_count) {
+    auto filename = (fs::temp_directory_path() / name).string();
+    auto stream = std::ofstream(filename, std::ios::binary);
+    stream << "0\nSECTION\n2\nENTITIES\n";
+    for (int i = 0; i < point_count; ++i) {
+        stream << "0\nPOINT\n5\n" << std::hex << 0x100 + i << std::dec
+               << "\n8\n0\n10\n" << i << "\n20\n0\n30\n0\n";
+    }
+    stream << "0\nENDSEC\n0\nEOF\n";
+    return filename;
+}
+
+TEST_CASE("Load multiple documents in parallel.", "[document][batch]") {
+    auto filenames = std::vector<std::string>{
+            write_dxf("ezdxf_410_small.dxf", 1),
+            write_dxf("ezdxf_410_medium.dxf", 100),
+            write_dxf("ezdxf_410_large.dxf", 10000),
+    };
+    auto pool = ezdxf::ThreadPool(2);
+    auto loader = ezdxf::BatchLoader(filenames, {}, pool);
+    REQUIRE(loader.size() == 3);
+
+    auto loaded = std::set<std::string>{};
+    while (auto result = loader.next()) {
+        REQUIRE(result->ok());
+        auto const &doc = result->document;
+        REQUIRE(doc.filename == result->filename);
+        auto const &section = doc.get_sections()[0];
+        if (result->filename == filenames[0])
+            REQUIRE(section.objects.size() == 1);
+        if (result->filename == filenames[2])
+            REQUIRE(section.objects.size() == 10000);
+        loaded.insert(result->filename);
+    }
+    REQUIRE(loaded.size() == 3);
+    REQUIRE(loader.next().has_value() == false);
+    for (auto const &filename : filenames) fs::remove(filename);
+}
+
+TEST_CASE("Batch loader reports per-file errors.", "[document][batch]") {
+    auto filename = write_dxf("ezdxf_410_valid.dxf", 10);
+    auto missing = (fs::temp_directory_path() / "ezdxf_410_missing.dxf")
+            .string();
+    auto results = ezdxf::readfiles({missing, filename});
+    REQUIRE(results.size() == 2);
+    for (auto const &result : results) {
+        if (result.filename == missing) {
+            REQUIRE(result.ok() == false);
+            REQUIRE(result.error == "Cannot open file");
+        } else {
+            REQUIRE(result.ok() == true);
+            REQUIRE(result.document.get_sections()[0].objects.size() == 10);
+        }
+    }
+    fs::remove(filename);
+}
+
+TEST_CASE("Batch loader applies the load options.", "[document][batch]") {
+    auto filename = write_dxf("ezdxf_410_filtered.dxf", 10);
+    auto results = ezdxf::readfiles(
+            {filename}, ezdxf::LoadOptions{{ezdxf::DXFType::Line}});
+    REQUIRE(results.size() == 1);
+    REQUIRE(results[0].document.get_sections()[0].objects.empty());
+    REQUIRE(results[0].document.get_skipped_handles().size() == 10);
+    fs::remove(filename);
+}
+
+TEST_CASE("Destroy batch loader before completion.", "[document][batch]") {
+    auto filename = write_dxf("ezdxf_410_cancel.dxf", 1000);
+    {
+        auto loader = ezdxf::BatchLoader(
+                std::vector<std::string>(8, filename));
+        REQUIRE(loader.next().has_value() == true);
+    }
+    // Wait for the running tasks, which still read the file:
+    while (ezdxf::ThreadPool::global().run_pending_task()) {}
+    auto results = ezdxf::readfiles({filename});
+    REQUIRE(results[0].ok());
+}
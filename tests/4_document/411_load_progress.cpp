@@ -0,0 +1,84 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <sstream>
+#include "ezdxf/ezdxf.hpp"
+
+using ezdxf::LoadOptions;
+using ezdxf::LoadProgress;
+
+static std::string make_dxf(int point_count) {
+    auto stream = std::ostringstream{};
+    stream << "0\nSECTION\n2\nHEADER\n9\n$ACADVER\n1\nAC1024\n0\nENDSEC\n"
+              "0\nSECTION\n2\nOBJECTS\n0\nDICTIONARY\n5\nC\n"
+              "0\nENDSEC\n0\nSECTION\n2\nENTITIES\n";
+    for (int i = 0; i < point_count; ++i) {
+        stream << "0\nPOINT\n5\n" << std::hex << 0x100 + i << std::dec
+               << "\n8\n0\n10\n" << i << "\n20\n0\n30\n0\n";
+    }
+    stream << "0\nENDSEC\n0\nEOF\n";
+    return stream.str();
+}
+
+static bool load(ezdxf::Document &doc, const std::string &data,
+                 const LoadOptions &options) {
+    auto basic_loader = ezdxf::tag::BasicLoader(data);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    return doc.load(loader, options);
+}
+
+TEST_CASE("Report the loading progress.", "[document][progress]") {
+    auto const data = make_dxf(100);
+    auto reports = std::vector<LoadProgress>{};
+    auto options = LoadOptions{};
+    options.progress_interval = 256;
+    options.progress = [&reports](const LoadProgress &progress) {
+        reports.push_back(progress);
+    };
+    auto doc = ezdxf::Document();
+    REQUIRE(load(doc, data, options) == true);
+    REQUIRE(reports.size() > 2);
+    // The final report is not aligned to the progress interval:
+    for (std::size_t i = 1; i < reports.size() - 1; ++i) {
+        REQUIRE(reports[i].bytes >= reports[i - 1].bytes + 256);
+        REQUIRE(reports[i].line_number > reports[i - 1].line_number);
+        REQUIRE(reports[i].entities >= reports[i - 1].entities);
+    }
+
+    SECTION("the final report contains the totals") {
+        auto const &last = reports.back();
+        REQUIRE(last.bytes == data.size());
+        REQUIRE(last.entities == 100);  // DICTIONARY is not an entity
+    }
+}
+
+TEST_CASE("Cancel loading.", "[document][progress]") {
+    auto const data = make_dxf(100);
+    auto options = LoadOptions{};
+    options.progress_interval = 256;
+
+    SECTION("cancel by the progress callback") {
+        auto token = options.cancellation;
+        options.progress = [token](const LoadProgress &progress) mutable {
+            if (progress.entities >= 10) token.cancel();
+        };
+        auto doc = ezdxf::Document();
+        REQUIRE(load(doc, data, options) == false);
+        auto const count = doc.query(ezdxf::DXFType::Point).size();
+        REQUIRE(count >= 10);
+        REQUIRE(count < 100);
+        REQUIRE(doc.get_errors().size() == 1);
+        REQUIRE(doc.get_errors()[0].code ==
+                ezdxf::ErrorCode::kLoadingCancelled);
+    }
+
+    SECTION("cancel in front of loading") {
+        options.cancellation.cancel();
+        auto doc = ezdxf::Document();
+        REQUIRE(load(doc, data, options) == false);
+        REQUIRE(doc.get_object_table().size() == 0);
+        REQUIRE(doc.get_errors()[0].code ==
+                ezdxf::ErrorCode::kLoadingCancelled);
+    }
+}
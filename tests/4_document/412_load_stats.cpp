@@ -0,0 +1,72 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <string>
+#include "ezdxf/ezdxf.hpp"
+
+using ezdxf::DXFType;
+using ezdxf::ErrorCode;
+using ezdxf::LoadPhase;
+using ezdxf::tag::TagType;
+
+static const std::string kDXF = "0\nSECTION\n2\nHEADER\n9\n$ACADVER\n1\n"
+                                "AC1024\n0\nENDSEC\n"
+                                "0\nSECTION\n2\nENTITIES\n"
+                                "0\nLINE\n5\n100\n8\n0\n"
+                                "10\n0\n20\n0\n30\n0\n11\n1\n21\n1\n31\n1\n"
+                                "0\nPOINT\n5\n101\n330\nFF\n"
+                                "0\nPOINT\n5\n101\n"
+                                "0\nENDSEC\n"
+                                "0\nSECTION\n2\nOBJECTS\n"
+                                "0\nDICTIONARY\n5\nC\n"
+                                "0\nENDSEC\n0\nEOF\n";
+
+TEST_CASE("Collect load statistics.", "[document][stats]") {
+    auto basic_loader = ezdxf::tag::BasicLoader(kDXF);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    auto doc = ezdxf::Document();
+    REQUIRE(doc.load(loader) == true);
+    auto const &stats = doc.get_load_stats();
+
+    SECTION("bytes and objects") {
+        REQUIRE(stats.bytes == kDXF.size());
+        // The duplicate POINT is counted as loaded object:
+        REQUIRE(stats.objects == 4);
+    }
+
+    SECTION("tags by type of the group code") {
+        REQUIRE(stats.count(TagType::kVec3) == 2);  // 10, 11
+        REQUIRE(stats.count(TagType::kReal) == 4);  // 20, 30, 21, 31
+        REQUIRE(stats.count(TagType::kString) == 22);
+        REQUIRE(stats.count(TagType::kInteger) == 0);
+    }
+
+    SECTION("entities by type") {
+        REQUIRE(stats.count(DXFType::Line) == 1);
+        REQUIRE(stats.count(DXFType::Point) == 2);
+        REQUIRE(stats.count(DXFType::Circle) == 0);
+    }
+
+    SECTION("errors by code") {
+        REQUIRE(stats.count(ErrorCode::kDuplicateHandle) == 1);
+        REQUIRE(stats.count(ErrorCode::kDanglingOwnerHandle) == 1);
+        REQUIRE(stats.count(ErrorCode::kInvalidStructure) == 0);
+    }
+
+    SECTION("wall time per phase") {
+        REQUIRE(stats.phase_seconds(LoadPhase::kParse) > 0.0);
+        REQUIRE(stats.phase_seconds(LoadPhase::kResolveReferences) >= 0.0);
+        REQUIRE(stats.total_seconds() >=
+                stats.phase_seconds(LoadPhase::kParse));
+    }
+}
+
+TEST_CASE("Statistics of a new document are empty.", "[document][stats]") {
+    auto doc = ezdxf::Document();
+    auto const &stats = doc.get_load_stats();
+    REQUIRE(stats.bytes == 0);
+    REQUIRE(stats.objects == 0);
+    REQUIRE(stats.errors.empty());
+    REQUIRE(stats.total_seconds() == 0.0);
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <sstream>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/acdb/columnar.hpp"
+
+using ezdxf::DXFType;
+using ezdxf::LoadOptions;
+using ezdxf::acdb::ColumnarEntity;
+
+// The LINE #104 without z-axis does not match the LINE columns:
+static const char *kDXF =
+        "0\nSECTION\n2\nENTITIES\n"
+        "0\nLINE\n5\n100\n100\nAcDbEntity\n8\nWALLS\n100\nAcDbLine\n"
+        "10\n1\n20\n2\n30\n0\n11\n4\n21\n6\n31\n0\n"
+        "0\nPOINT\n5\n101\n100\nAcDbEntity\n8\n0\n100\nAcDbPoint\n"
+        "10\n-1\n20\n0.5\n30\n3\n"
+        "0\nCIRCLE\n5\n102\n100\nAcDbEntity\n8\n0\n100\nAcDbCircle\n"
+        "39\n1\n10\n5\n20\n5\n30\n0\n40\n2.5\n"
+        "0\nARC\n5\n103\n100\nAcDbEntity\n8\n0\n100\nAcDbCircle\n"
+        "10\n0\n20\n0\n30\n0\n40\n1\n100\nAcDbArc\n50\n0\n51\n90\n"
+        "0\nLINE\n5\n104\n8\n0\n10\n0\n20\n0\n11\n100\n21\n100\n"
+        "0\nENDSEC\n0\nEOF\n";
+
+static ezdxf::Document load(const LoadOptions &options) {
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(kDXF);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    REQUIRE(doc.load(loader, options) == true);
+    return doc;
+}
+
+static LoadOptions columnar() {
+    auto options = LoadOptions{};
+    options.columnar_geometry = true;
+    return options;
+}
+
+static std::string export_dxf(const ezdxf::Document &doc) {
+    auto stream = std::ostringstream{};
+    doc.export_dxf(stream);
+    return stream.str();
+}
+
+TEST_CASE("Load geometry in columnar storage mode.", "[document][columnar]") {
+    auto doc = load(columnar());
+    REQUIRE(doc.get_errors().empty());
+    auto store = doc.get_geometry_store();
+    REQUIRE(store != nullptr);
+    REQUIRE(store->size() == 4);
+
+    auto line = dynamic_cast<ColumnarEntity *>(doc.get(0x100));
+    REQUIRE(line != nullptr);
+    REQUIRE(line->dxf_type() == DXFType::Line);
+    REQUIRE(line->get_layer() == "WALLS");
+    REQUIRE(line->row() == 0);
+    REQUIRE(line->value(21) == 6.0);
+    // The geometry tags are not stored as raw tags:
+    REQUIRE(line->find_raw_tag(10) == nullptr);
+
+    auto const &lines = store->lines();
+    REQUIRE(lines.size() == 1);
+    REQUIRE(lines.entity(0) == line);
+    REQUIRE(lines.column(11)[0] == 4.0);
+    REQUIRE(store->points().column(20)[0] == 0.5);
+    REQUIRE(store->circles().column(40)[0] == 2.5);
+    REQUIRE(store->arcs().column(51)[0] == 90.0);
+    REQUIRE_THROWS_AS(lines.column(40), std::invalid_argument);
+
+    SECTION("entities without matching geometry tags are not columnar") {
+        REQUIRE(dynamic_cast<ColumnarEntity *>(doc.get(0x104)) == nullptr);
+        REQUIRE(doc.query(DXFType::Line).size() == 2);
+    }
+
+    SECTION("export geometry tags at their original position") {
+        REQUIRE(export_dxf(doc) == export_dxf(load(LoadOptions{})));
+    }
+}
+
+TEST_CASE("Columnar geometry kernels.", "[document][columnar]") {
+    auto doc = load(columnar());
+    auto store = doc.get_geometry_store();
+    auto box = store->bounding_box();
+    REQUIRE(box.has_value());
+    REQUIRE(box->first.is_close(ezdxf::math::Vec3(-1, 0.5, 0)));
+    REQUIRE(box->second.is_close(ezdxf::math::Vec3(4, 6, 3)));
+
+    store->translate(10, 0, -1);
+    auto line = static_cast<ColumnarEntity *>(doc.get(0x100));
+    REQUIRE(line->value(10) == 11.0);
+    REQUIRE(line->value(31) == -1.0);
+    // Circles and arcs are not translated:
+    REQUIRE(store->circles().column(10)[0] == 5.0);
+    REQUIRE(export_dxf(doc).find(" 11\n14\n") != std::string::npos);
+}
+
+TEST_CASE("Purge erased columnar entities.", "[document][columnar]") {
+    auto doc = load(columnar());
+    auto store = doc.get_geometry_store();
+    auto const arc = static_cast<ColumnarEntity *>(doc.get(0x103));
+    doc.erase(doc.get(0x101));
+    doc.erase(doc.get(0x102));
+    REQUIRE(store->size() == 4);
+    doc.purge();
+    REQUIRE(store->size() == 2);
+    REQUIRE(store->points().size() == 0);
+    REQUIRE(store->arcs().entity(0) == arc);
+    REQUIRE(arc->value(51) == 90.0);
+}
+
+TEST_CASE("Snapshot of columnar entities.", "[document][columnar]") {
+    auto doc = load(columnar());
+    auto stream = std::stringstream{};
+    REQUIRE(doc.save_snapshot(stream) == true);
+    auto restored = ezdxf::Document();
+    REQUIRE(restored.load_snapshot(stream) == true);
+    REQUIRE(export_dxf(restored) == export_dxf(doc));
+}
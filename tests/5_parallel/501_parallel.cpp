@@ -0,0 +1,149 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+// Run this tests also with ThreadSanitizer:
+// cmake -DEZDXF_SANITIZE_THREAD=ON ...
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/acdb/entity.hpp"
+#include "ezdxf/parallel.hpp"
+
+using ezdxf::DXFType;
+using ezdxf::Handle;
+
+TEST_CASE("Thread pool processes all submitted tasks.", "[parallel]") {
+    std::atomic<int> counter{0};
+    {
+        auto pool = ezdxf::ThreadPool(3);
+        REQUIRE(pool.size() == 3);
+        for (int i = 0; i < 1000; ++i) pool.submit([&counter]() { ++counter; });
+    }  // destructor processes pending tasks
+    REQUIRE(counter == 1000);
+}
+
+TEST_CASE("Nested parallel loops do not deadlock.", "[parallel]") {
+    auto pool = ezdxf::ThreadPool(2);
+    std::atomic<std::size_t> counter{0};
+    ezdxf::parallel_for(
+            pool, 8, 1, [&pool, &counter](std::size_t, std::size_t,
+                                          std::size_t) {
+                ezdxf::parallel_for(
+                        pool, 100, 10,
+                        [&counter](std::size_t, std::size_t begin,
+                                   std::size_t end) {
+                            counter += end - begin;
+                        });
+            });
+    REQUIRE(counter == 800);
+}
+
+TEST_CASE("Parallel for covers the index range once.", "[parallel]") {
+    auto pool = ezdxf::ThreadPool(4);
+    auto hits = std::vector<int>(10007, 0);
+    ezdxf::parallel_for(pool, hits.size(), 100,
+                        [&hits](std::size_t, std::size_t begin,
+                                std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) ++hits[i];
+                        });
+    REQUIRE(std::count(hits.begin(), hits.end(), 1) == 10007);
+
+    SECTION("empty range") {
+        bool called = false;
+        ezdxf::parallel_for(pool, 0, 100,
+                            [&called](std::size_t, std::size_t, std::size_t) {
+                                called = true;
+                            });
+        REQUIRE(called == false);
+    }
+}
+
+TEST_CASE("Parallel for rethrows exceptions.", "[parallel]") {
+    auto pool = ezdxf::ThreadPool(4);
+    REQUIRE_THROWS_AS(ezdxf::parallel_for(
+            pool, 100, 1, [](std::size_t chunk, std::size_t, std::size_t) {
+                if (chunk == 50) throw std::runtime_error("chunk 50");
+            }), std::runtime_error);
+}
+
+TEST_CASE("Parallel reduce is deterministic.", "[parallel]") {
+    auto pool = ezdxf::ThreadPool(4);
+    auto values = std::vector<int>(100000);
+    std::iota(values.begin(), values.end(), 0);
+
+    auto sum = ezdxf::parallel_reduce(
+            pool, values, int64_t(0), [](int v) { return int64_t(v); },
+            [](int64_t a, int64_t b) { return a + b; });
+    REQUIRE(sum == int64_t(99999) * 100000 / 2);
+
+    SECTION("not commutative reduce function") {
+        auto strings = std::vector<std::string>(5000);
+        for (std::size_t i = 0; i < strings.size(); ++i)
+            strings[i] = std::string(1, char('a' + i % 26));
+        auto concat = ezdxf::parallel_reduce(
+                pool, strings, std::string{},
+                [](const std::string &s) { return s; },
+                [](const std::string &a, const std::string &b) {
+                    return a + b;
+                });
+        REQUIRE(concat == std::accumulate(strings.begin(), strings.end(),
+                                          std::string{}));
+    }
+
+    SECTION("bool results") {
+        auto any_negative = ezdxf::parallel_reduce(
+                pool, values, false, [](int v) { return v < 0; },
+                [](bool a, bool b) { return a || b; });
+        REQUIRE(any_negative == false);
+    }
+}
+
+static std::string make_dxf(Handle count) {
+    // Modelspace BLOCK_RECORD #1 and alternating LINE and CIRCLE entities
+    // starting at handle #100:
+    auto s = std::ostringstream{};
+    s << std::uppercase << std::hex;
+    s << "0\nSECTION\n2\nTABLES\n0\nBLOCK_RECORD\n5\n1\n2\n*Model_Space\n"
+         "0\nENDSEC\n0\nSECTION\n2\nENTITIES\n";
+    for (Handle h = 0x100; h < 0x100 + count; ++h) {
+        s << "0\n" << (h & 1 ? "CIRCLE" : "LINE") << "\n5\n" << h
+          << "\n330\n1\n8\n" << (h % 3 ? "0" : "WALLS") << "\n";
+    }
+    s << "0\nENDSEC\n0\nEOF\n";
+    return s.str();
+}
+
+TEST_CASE("Parallel algorithms over entity queries.", "[parallel][document]") {
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(make_dxf(20000));
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    REQUIRE(doc.load(loader) == true);
+    doc.freeze();
+    auto pool = ezdxf::ThreadPool(4);
+    const auto &lines = doc.query(DXFType::Line);
+    REQUIRE(lines.size() == 10000);
+
+    std::atomic<std::size_t> on_walls{0};
+    ezdxf::parallel_for_each(pool, lines, [&on_walls](const ezdxf::Object *o) {
+        auto entity = static_cast<const ezdxf::acdb::Entity *>(o);
+        if (entity->get_layer() == "WALLS") ++on_walls;
+    });
+    auto max_handle = ezdxf::parallel_reduce(
+            pool, lines, Handle(0),
+            [](const ezdxf::Object *o) { return o->get_handle(); },
+            [](Handle a, Handle b) { return std::max(a, b); });
+
+    std::size_t expected_on_walls = 0;
+    for (auto o : lines) {
+        if (static_cast<const ezdxf::acdb::Entity *>(o)->get_layer() ==
+            "WALLS")
+            ++expected_on_walls;
+    }
+    REQUIRE(on_walls == expected_on_walls);
+    REQUIRE(max_handle == 0x100 + 20000 - 2);
+}
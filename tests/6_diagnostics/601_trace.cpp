@@ -0,0 +1,79 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <sstream>
+#include "ezdxf/ezdxf.hpp"
+#include "ezdxf/parallel.hpp"
+#include "ezdxf/trace.hpp"
+
+namespace trace = ezdxf::trace;
+
+static const char *kDXF = "0\nSECTION\n2\nENTITIES\n"
+                          "0\nPOINT\n5\n100\n"
+                          "0\nENDSEC\n0\nEOF\n";
+
+static std::string load_and_trace() {
+    trace::start();
+    auto doc = ezdxf::Document();
+    auto basic_loader = ezdxf::tag::BasicLoader(kDXF);
+    auto loader = ezdxf::tag::AscLoader(basic_loader);
+    doc.load(loader);
+    auto stream = std::ostringstream{};
+    doc.export_dxf(stream);
+    trace::stop();
+    auto json = std::ostringstream{};
+    trace::write_chrome_trace(json);
+    return json.str();
+}
+
+TEST_CASE("Disabled tracing records nothing.", "[trace]") {
+    trace::start();
+    trace::stop();
+    {
+        auto span = trace::Span("not recorded");
+    }
+    REQUIRE(trace::is_enabled() == false);
+    REQUIRE(trace::size() == 0);
+}
+
+TEST_CASE("Trace loading and export stages.", "[trace]") {
+    auto json = load_and_trace();
+    REQUIRE(json.rfind(R"({"displayTimeUnit":"ms","traceEvents":[)", 0) == 0);
+    for (const char *name : {"load", "parse", "assign handles",
+                             "resolve references", "build indices",
+                             "export", "export section"}) {
+        auto event = std::string(R"("name":")") + name + '"';
+        INFO(name);
+        REQUIRE(json.find(event) != std::string::npos);
+    }
+    REQUIRE(json.find(R"("args":{"detail":"ENTITIES"})") != std::string::npos);
+    REQUIRE(json.find(R"("ph":"X")") != std::string::npos);
+}
+
+TEST_CASE("Trace parallel chunks of worker threads.", "[trace]") {
+    trace::start();
+    {
+        auto pool = ezdxf::ThreadPool(2);
+        ezdxf::parallel_for(pool, 4, 1, [](std::size_t, std::size_t,
+                                           std::size_t) {});
+    }  // the trace data outlives the worker threads
+    trace::stop();
+    REQUIRE(trace::size() == 4);
+    auto json = std::ostringstream{};
+    trace::write_chrome_trace(json);
+    REQUIRE(json.str().find(R"("name":"parallel chunk")") !=
+            std::string::npos);
+}
+
+TEST_CASE("Escape JSON strings.", "[trace]") {
+    trace::start();
+    {
+        auto span = trace::Span("file", "C:\\dxf\\\"a\".dxf");
+    }
+    trace::stop();
+    auto json = std::ostringstream{};
+    trace::write_chrome_trace(json);
+    REQUIRE(json.str().find(R"("detail":"C:\\dxf\\\"a\".dxf")") !=
+            std::string::npos);
+}
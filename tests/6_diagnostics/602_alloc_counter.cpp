@@ -0,0 +1,57 @@
+// Copyright (c) 2021, Manfred Moitzi
+// License: MIT License
+//
+#include <catch2/catch.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "ezdxf/alloc_counter.hpp"
+
+using ezdxf::alloc::AllocationCounter;
+
+TEST_CASE("Count allocations by operator new.", "[alloc]") {
+    auto counter = AllocationCounter();
+    REQUIRE(counter.stats().allocations == 0);
+    {
+        auto value = std::make_unique<int64_t>(1);
+        auto array = std::unique_ptr<char[]>(new char[100]);
+        auto const stats = counter.stats();
+        REQUIRE(stats.allocations == 2);
+        REQUIRE(stats.bytes == 108);
+        REQUIRE(stats.deallocations == 0);
+    }
+    REQUIRE(counter.stats().deallocations == 2);
+}
+
+TEST_CASE("Count aligned allocations.", "[alloc]") {
+    struct alignas(64) Block {
+        char data[64];
+    };
+    auto counter = AllocationCounter();
+    auto block = std::make_unique<Block>();
+    REQUIRE(reinterpret_cast<uintptr_t>(block.get()) % 64 == 0);
+    REQUIRE(counter.stats().allocations == 1);
+    REQUIRE(counter.stats().bytes == 64);
+}
+
+TEST_CASE("Count allocations of all threads.", "[alloc]") {
+    auto counter = AllocationCounter();
+    auto thread = std::thread([]() {
+        auto values = std::vector<int>(1000);
+    });
+    thread.join();
+    // std::thread allocates its own state:
+    REQUIRE(counter.stats().allocations >= 2);
+    REQUIRE(counter.stats().bytes >= 4000);
+}
+
+TEST_CASE("Nested counters.", "[alloc]") {
+    auto outer = AllocationCounter();
+    auto first = std::make_unique<int>(1);
+    {
+        auto inner = AllocationCounter();
+        auto second = std::make_unique<int>(2);
+        REQUIRE(inner.stats().allocations == 1);
+    }
+    REQUIRE(outer.stats().allocations == 2);
+}